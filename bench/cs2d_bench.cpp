@@ -0,0 +1,416 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// cs2d_bench.cpp - 生成器、预估器与导出热路径的固定种子基准
+//
+// 用法: cs2d_bench [--json <file|->] [--filter <子串>] [--min-time <秒>]
+//   每项基准自动倍增迭代次数直到总用时不少于 min-time (默认 0.2 秒), 报告:
+//   ns/op (单次操作), ops/s, ns/item (按每次操作处理的子板类型数折算)
+//   --json 写出机器可读结果, 便于逐版本跟踪吞吐
+//
+// 基准项:
+//   generate/<策略>/n<种类数>/<母板>  策略 reverse/random/cluster/residual x 种类数 x 母板尺寸
+//   estimate/...  estimate_batch/...   预估 (含统计量与条带模式) / 批量评分
+//   calibrate/closed_form  calibrate/grid_search
+//   csv_format  csv_write  csv_parse  corpus_encode
+
+#include "cs2d_data.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifndef CS2D_DATA_VERSION
+#define CS2D_DATA_VERSION "unknown"
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kSeed = 20240601;
+
+// 防止结果被优化掉
+volatile uint64_t g_sink = 0;
+
+struct Benchmark {
+    std::string name;
+    // 执行 iterations 次操作, 返回处理的子板类型总数 (无子板概念时返回 0)
+    std::function<uint64_t(uint64_t iterations)> run;
+};
+
+struct BenchResult {
+    std::string name;
+    uint64_t iterations = 0;
+    uint64_t items = 0;
+    double seconds = 0.0;
+
+    double NsPerOp() const { return seconds * 1e9 / iterations; }
+    double OpsPerSecond() const { return seconds > 0.0 ? iterations / seconds : 0.0; }
+    double NsPerItem() const { return items > 0 ? seconds * 1e9 / items : 0.0; }
+};
+
+const char* StrategyName(int strategy) {
+    static const char* kNames[] = {"reverse", "random", "cluster", "residual"};
+    return kNames[strategy];
+}
+
+GeneratorParams MakeParams(int strategy, int num_types, int stock_width, int stock_length) {
+    GeneratorParams params = GeneratorParams::FromPreset(Preset::kMedium);
+    params.strategy = strategy;
+    params.num_types = num_types;
+    params.stock_width = stock_width;
+    params.stock_length = stock_length;
+    params.large_scale = num_types > GeneratorParams::kMaxTypes;
+    if (params.large_scale) {
+        // 大规模模式下缩小尺寸比, 否则子板尺寸空间不足以容纳如此多的种类
+        params.min_size_ratio = 0.01;
+        params.max_size_ratio = 0.05;
+    }
+    params.seed = kSeed;
+    return params;
+}
+
+// 固定种子的一组算例 (供预估与序列化基准使用)
+std::vector<Instance> MakeInstances(const GeneratorParams& params, int count) {
+    InstanceGenerator generator(kSeed);
+    std::vector<Instance> instances;
+    instances.reserve(count);
+    for (int k = 0; k < count; k++) {
+        GenerationResult result = generator.Generate(params, static_cast<uint64_t>(k));
+        if (result.success) instances.push_back(std::move(result.instance));
+    }
+    return instances;
+}
+
+uint64_t TotalTypes(const std::vector<Instance>& instances) {
+    uint64_t n = 0;
+    for (const auto& inst : instances) n += inst.items.size();
+    return n;
+}
+
+std::string Escape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+void AddGenerateBenchmarks(std::vector<Benchmark>& benchmarks) {
+    struct Stock { int width; int length; const char* label; };
+    const Stock stocks[] = {{200, 400, "200x400"}, {2000, 4000, "2000x4000"}};
+    const int type_counts[] = {10, 50, 200, 2000};
+
+    for (int strategy = 0; strategy < 4; strategy++) {
+        for (int num_types : type_counts) {
+            for (const Stock& stock : stocks) {
+                // 小母板无法容纳大规模种类数
+                if (num_types > GeneratorParams::kMaxTypes && stock.width < 1000) continue;
+                GeneratorParams params = MakeParams(strategy, num_types, stock.width, stock.length);
+                std::string name = std::string("generate/") + StrategyName(strategy) + "/n" +
+                                   std::to_string(num_types) + "/" + stock.label;
+                benchmarks.push_back({name, [params](uint64_t iterations) {
+                    InstanceGenerator generator(kSeed);
+                    GenerationResult result;
+                    uint64_t items = 0;
+                    for (uint64_t k = 0; k < iterations; k++) {
+                        generator.GenerateInto(params, k, result);
+                        items += result.instance.items.size();
+                    }
+                    return items;
+                }});
+            }
+        }
+    }
+}
+
+// 子板尺寸抽样: 批量内核与逐个抽取的参考路径 (每次操作抽取 1024 个)
+void AddItemSizeBenchmarks(std::vector<Benchmark>& benchmarks) {
+    constexpr int kSizes = 1024;
+    for (bool prime_offset : {false, true}) {
+        GeneratorParams params = MakeParams(1, 2000, 2000, 4000);
+        params.prime_offset = prime_offset;
+        const std::string suffix = prime_offset ? "/prime" : "/plain";
+        for (bool batched : {true, false}) {
+            std::string name = std::string("item_sizes/") + (batched ? "batched" : "scalar") + suffix;
+            benchmarks.push_back({name, [params, batched](uint64_t iterations) {
+                InstanceGenerator generator(kSeed);
+                std::vector<int> w(kSizes), l(kSizes);
+                uint64_t sum = 0;
+                for (uint64_t k = 0; k < iterations; k++) {
+                    if (batched) {
+                        generator.GenerateItemSizes(params, kSizes, w.data(), l.data());
+                    } else {
+                        generator.GenerateItemSizesScalar(params, kSizes, w.data(), l.data());
+                    }
+                    sum += static_cast<uint64_t>(w[k % kSizes] + l[0]);
+                }
+                g_sink = g_sink + sum;
+                return iterations * kSizes;
+            }});
+        }
+    }
+}
+
+void AddEstimatorBenchmarks(std::vector<Benchmark>& benchmarks) {
+    for (int num_types : {20, 200}) {
+        auto instances = std::make_shared<std::vector<Instance>>(
+            MakeInstances(MakeParams(1, num_types, 200, 400), 64));
+        const uint64_t types = TotalTypes(*instances);
+        const std::string suffix = "/n" + std::to_string(num_types);
+
+        benchmarks.push_back({"estimate" + suffix, [instances](uint64_t iterations) {
+            DifficultyEstimator estimator;
+            uint64_t items = 0;
+            double sum = 0.0;
+            for (uint64_t k = 0; k < iterations; k++) {
+                Instance& inst = (*instances)[k % instances->size()];
+                inst.InvalidateStats();     // 计入单遍统计量
+                sum += estimator.Estimate(inst).score;
+                items += inst.items.size();
+            }
+            g_sink = g_sink + static_cast<uint64_t>(sum);
+            return items;
+        }});
+
+        // 批量评分: 一次操作 = 对全部统计量评分一遍
+        benchmarks.push_back({"estimate_batch" + suffix, [instances, types](uint64_t iterations) {
+            DifficultyEstimator estimator;
+            std::vector<InstanceStats> stats;
+            for (const auto& inst : *instances) stats.push_back(inst.Stats());
+            std::vector<double> scores(stats.size());
+            std::vector<DifficultyLevel> levels(stats.size());
+            for (uint64_t k = 0; k < iterations; k++) {
+                estimator.EstimateBatch(stats.data(), stats.size(), scores.data(), levels.data());
+            }
+            g_sink = g_sink + static_cast<uint64_t>(scores[0]);
+            return types * iterations;
+        }});
+    }
+}
+
+void AddCalibrationBenchmarks(std::vector<Benchmark>& benchmarks) {
+    // 500 个合成校准点: 预估评分加固定扰动作为"实际" Gap
+    auto base = std::make_shared<DifficultyEstimator>();
+    std::vector<Instance> instances = MakeInstances(MakeParams(1, 30, 200, 400), 500);
+    for (size_t k = 0; k < instances.size(); k++) {
+        const Instance& inst = instances[k];
+        CalibrationPoint point;
+        point.num_types = inst.NumTypes();
+        point.avg_size_ratio = inst.AvgSizeRatio();
+        point.avg_demand = inst.AvgDemand();
+        point.size_cv = inst.SizeCV();
+        point.width_diversity = inst.WidthDiversity();
+        point.strip_patterns = DifficultyEstimator::CountStripPatterns(inst);
+        point.actual_gap = 0.01 * base->Score(inst) + 0.002 * static_cast<double>(k % 7);
+        point.actual_nodes = 0;
+        point.solve_time = 0.0;
+        point.timed_out = false;
+        base->AddCalibrationPoint(point);
+    }
+
+    const std::pair<const char*, CalibrationMethod> methods[] = {
+        {"calibrate/closed_form", CalibrationMethod::kClosedForm},
+        {"calibrate/grid_search", CalibrationMethod::kGridSearch},
+    };
+    for (const auto& m : methods) {
+        CalibrationMethod method = m.second;
+        benchmarks.push_back({m.first, [base, method](uint64_t iterations) {
+            double sum = 0.0;
+            for (uint64_t k = 0; k < iterations; k++) {
+                DifficultyEstimator estimator = *base;
+                sum += estimator.Calibrate(method);
+            }
+            g_sink = g_sink + static_cast<uint64_t>(sum * 1e6);
+            return uint64_t{0};
+        }});
+    }
+}
+
+void AddSerializationBenchmarks(std::vector<Benchmark>& benchmarks) {
+    auto instances = std::make_shared<std::vector<Instance>>(
+        MakeInstances(MakeParams(1, 50, 200, 400), 64));
+    auto texts = std::make_shared<std::vector<std::string>>();
+    {
+        CsvSerializer serializer;
+        for (const auto& inst : *instances) texts->push_back(serializer.Format(inst));
+    }
+
+    benchmarks.push_back({"csv_format", [instances](uint64_t iterations) {
+        CsvSerializer serializer;
+        uint64_t items = 0, bytes = 0;
+        for (uint64_t k = 0; k < iterations; k++) {
+            const Instance& inst = (*instances)[k % instances->size()];
+            bytes += serializer.Format(inst).size();
+            items += inst.items.size();
+        }
+        g_sink = g_sink + bytes;
+        return items;
+    }});
+
+    benchmarks.push_back({"csv_write", [instances](uint64_t iterations) {
+        std::filesystem::path dir = std::filesystem::temp_directory_path() / "cs2d_bench";
+        std::filesystem::create_directories(dir);
+        const std::string path = (dir / "inst.csv").string();
+        CsvSerializer serializer;
+        uint64_t items = 0;
+        for (uint64_t k = 0; k < iterations; k++) {
+            const Instance& inst = (*instances)[k % instances->size()];
+            serializer.Write(inst, path);
+            items += inst.items.size();
+        }
+        std::error_code ec;
+        std::filesystem::remove_all(dir, ec);
+        return items;
+    }});
+
+    benchmarks.push_back({"csv_parse", [texts](uint64_t iterations) {
+        Instance inst;
+        std::string error;
+        uint64_t items = 0;
+        for (uint64_t k = 0; k < iterations; k++) {
+            const std::string& text = (*texts)[k % texts->size()];
+            CsvReader::Parse(text.data(), text.size(), inst, error);
+            items += inst.items.size();
+        }
+        return items;
+    }});
+
+    benchmarks.push_back({"corpus_encode", [instances](uint64_t iterations) {
+        std::vector<unsigned char> record;
+        uint64_t items = 0, bytes = 0;
+        for (uint64_t k = 0; k < iterations; k++) {
+            const Instance& inst = (*instances)[k % instances->size()];
+            EncodeCorpusRecord(k, inst, 1.0, record);
+            bytes += record.size();
+            items += inst.items.size();
+        }
+        g_sink = g_sink + bytes;
+        return items;
+    }});
+}
+
+// 倍增迭代次数直到总用时不少于 min_time
+BenchResult RunBenchmark(const Benchmark& benchmark, double min_time) {
+    BenchResult result;
+    result.name = benchmark.name;
+    uint64_t iterations = 1;
+    for (;;) {
+        auto start = Clock::now();
+        uint64_t items = benchmark.run(iterations);
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        if (seconds >= min_time || iterations >= (1ULL << 40)) {
+            result.iterations = iterations;
+            result.items = items;
+            result.seconds = seconds;
+            return result;
+        }
+        // 按已测速度估计所需次数, 至少翻倍, 至多放大 10 倍
+        double scale = seconds > 0.0 ? 1.2 * min_time / seconds : 10.0;
+        iterations = static_cast<uint64_t>(iterations * std::clamp(scale, 2.0, 10.0));
+    }
+}
+
+bool WriteJson(const std::vector<BenchResult>& results, double min_time, std::ostream& out) {
+    out << "{\n";
+    out << "  \"version\": \"" << CS2D_DATA_VERSION << "\",\n";
+    out << "  \"seed\": " << kSeed << ",\n";
+    out << "  \"min_time\": " << min_time << ",\n";
+    out << "  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        char line[512];
+        std::snprintf(line, sizeof(line),
+                      "    {\"name\": \"%s\", \"iterations\": %llu, \"items\": %llu, "
+                      "\"seconds\": %.6f, \"ns_per_op\": %.1f, \"ops_per_sec\": %.1f, "
+                      "\"ns_per_item\": %.2f}%s\n",
+                      Escape(r.name).c_str(), static_cast<unsigned long long>(r.iterations),
+                      static_cast<unsigned long long>(r.items), r.seconds, r.NsPerOp(),
+                      r.OpsPerSecond(), r.NsPerItem(), i + 1 < results.size() ? "," : "");
+        out << line;
+    }
+    out << "  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+void PrintUsage(const char* program) {
+    std::cout << "Usage: " << program << " [--json <file|->] [--filter <substring>] [--min-time <sec>]\n";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string json_path;
+    std::string filter;
+    double min_time = 0.2;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            PrintUsage(argv[0]);
+            return 0;
+        } else if (arg == "--json" && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            min_time = std::stod(argv[++i]);
+        } else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<Benchmark> benchmarks;
+    AddGenerateBenchmarks(benchmarks);
+    AddItemSizeBenchmarks(benchmarks);
+    AddEstimatorBenchmarks(benchmarks);
+    AddCalibrationBenchmarks(benchmarks);
+    AddSerializationBenchmarks(benchmarks);
+
+    // JSON 写到 stdout 时, 表格改写到 stderr
+    std::ostream& table = json_path == "-" ? std::cerr : std::cout;
+    char line[256];
+    std::snprintf(line, sizeof(line), "%-40s %12s %14s %12s %10s\n",
+                  "benchmark", "iterations", "ns/op", "ops/s", "ns/item");
+    table << line;
+
+    std::vector<BenchResult> results;
+    for (const Benchmark& benchmark : benchmarks) {
+        if (!filter.empty() && benchmark.name.find(filter) == std::string::npos) continue;
+        BenchResult r = RunBenchmark(benchmark, min_time);
+        std::snprintf(line, sizeof(line), "%-40s %12llu %14.1f %12.1f %10.2f\n",
+                      r.name.c_str(), static_cast<unsigned long long>(r.iterations),
+                      r.NsPerOp(), r.OpsPerSecond(), r.NsPerItem());
+        table << line << std::flush;
+        results.push_back(r);
+    }
+
+    if (json_path == "-") {
+        return WriteJson(results, min_time, std::cout) ? 0 : 1;
+    }
+    if (!json_path.empty()) {
+        std::ofstream file(json_path);
+        if (!file.is_open() || !WriteJson(results, min_time, file)) {
+            std::cerr << "Error: Cannot write " << json_path << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}
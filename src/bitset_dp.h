@@ -0,0 +1,116 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// bitset_dp.h - 位集子集和动态规划
+// 可达集合 R ⊆ [0, capacity] 以64位字存储, 加入一个可无限重复的物品长度 s 时
+// 以倍增移位 R |= R << s, R |= R << 2s, ... 完成, 代价 O(capacity/64 * log(capacity/s))
+
+#ifndef CS_2D_DATA_BITSET_DP_H_
+#define CS_2D_DATA_BITSET_DP_H_
+
+#include <cstdint>
+#include <vector>
+
+class ReachBitset {
+public:
+    // 清空并设定容量, 初始可达集合为 {0}
+    void Reset(int capacity) {
+        capacity_ = capacity;
+        num_words_ = static_cast<size_t>(capacity) / 64 + 1;
+        if (words_.size() < num_words_) {
+            words_.resize(num_words_);
+        }
+        for (size_t i = 0; i < num_words_; i++) words_[i] = 0;
+        words_[0] = 1;
+    }
+
+    bool Test(int pos) const {
+        return pos >= 0 && pos <= capacity_ &&
+               ((words_[pos >> 6] >> (pos & 63)) & 1ULL) != 0;
+    }
+
+    // 加入可无限重复使用的长度 s (s <= 0 忽略)
+    void AddUnbounded(int s) {
+        if (s <= 0 || s > capacity_) return;
+        for (long long shift = s; shift <= capacity_; shift <<= 1) {
+            ShiftOr(static_cast<int>(shift));
+        }
+    }
+
+    // 可达值个数 (含0)
+    int Count() const {
+        int total = 0;
+        for (size_t i = 0; i < num_words_; i++) total += PopCount(words_[i]);
+        return total;
+    }
+
+    // [0, capacity] 是否全部可达
+    bool Full() const { return Count() == capacity_ + 1; }
+
+    // 不超过 limit 的最大可达值
+    int HighestAtMost(int limit) const {
+        if (limit > capacity_) limit = capacity_;
+        if (limit < 0) return -1;
+        size_t w = static_cast<size_t>(limit) >> 6;
+        uint64_t word = words_[w] & MaskUpTo(limit & 63);
+        for (;;) {
+            if (word != 0) {
+                return static_cast<int>(w * 64 + 63 - CountLeadingZeros(word));
+            }
+            if (w == 0) return -1;
+            word = words_[--w];
+        }
+    }
+
+private:
+    std::vector<uint64_t> words_;
+    size_t num_words_ = 0;
+    int capacity_ = 0;
+
+    // R |= R << shift (自高位字向低位字原地更新)
+    void ShiftOr(int shift) {
+        const size_t word_shift = static_cast<size_t>(shift) >> 6;
+        const int bit_shift = shift & 63;
+        for (size_t i = num_words_; i-- > word_shift;) {
+            const size_t src = i - word_shift;
+            uint64_t v = words_[src] << bit_shift;
+            if (bit_shift != 0 && src > 0) {
+                v |= words_[src - 1] >> (64 - bit_shift);
+            }
+            words_[i] |= v;
+        }
+        // 清除容量之外的位
+        words_[num_words_ - 1] &= MaskUpTo(capacity_ & 63);
+    }
+
+    static uint64_t MaskUpTo(int bit) {
+        return bit == 63 ? ~0ULL : ((1ULL << (bit + 1)) - 1);
+    }
+
+    static int PopCount(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(x);
+#else
+        int n = 0;
+        for (; x != 0; x &= x - 1) n++;
+        return n;
+#endif
+    }
+
+    static int CountLeadingZeros(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_clzll(x);
+#else
+        int n = 0;
+        for (uint64_t bit = 1ULL << 63; (x & bit) == 0; bit >>= 1) n++;
+        return n;
+#endif
+    }
+};
+
+#endif  // CS_2D_DATA_BITSET_DP_H_
@@ -0,0 +1,116 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// bounded_queue.h - 有界无锁多生产者多消费者队列
+// Vyukov 环形队列: 每个单元携带序号, 入队/出队各需一次 CAS, 无堆分配;
+// 容量向上取整为2的幂, 满/空时 TryPush/TryPop 立即返回 false, 由调用方决定等待策略
+
+#ifndef CS_2D_DATA_BOUNDED_QUEUE_H_
+#define CS_2D_DATA_BOUNDED_QUEUE_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        mask_ = size - 1;
+        cells_.reset(new Cell[size]);
+        for (size_t i = 0; i < size; i++) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        enqueue_pos_.store(0, std::memory_order_relaxed);
+        dequeue_pos_.store(0, std::memory_order_relaxed);
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    size_t Capacity() const { return mask_ + 1; }
+
+    // 入队, 队列满时返回 false
+    bool TryPush(const T& value) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                                       std::memory_order_relaxed)) {
+                    cell.data = value;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // 出队, 队列空时返回 false
+    bool TryPop(T& value) {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                                       std::memory_order_relaxed)) {
+                    value = cell.data;
+                    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_ = 0;
+    // 生产端与消费端游标分处不同缓存行, 避免伪共享
+    alignas(64) std::atomic<size_t> enqueue_pos_;
+    alignas(64) std::atomic<size_t> dequeue_pos_;
+};
+
+// 等待退避: 先自旋让出, 长时间等待后短暂休眠, 避免空等占满核心
+class Backoff {
+public:
+    void Wait() {
+        if (++spins_ < 64) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+    void Reset() { spins_ = 0; }
+
+private:
+    int spins_ = 0;
+};
+
+#endif  // CS_2D_DATA_BOUNDED_QUEUE_H_
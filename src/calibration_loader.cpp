@@ -0,0 +1,342 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// calibration_loader.cpp - 校准数据批量导入实现
+
+#include "calibration_loader.h"
+#include "csv_io.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+constexpr char kStoreMagic[8] = {'C', 'S', '2', 'D', 'C', 'A', 'L', 'P'};
+// 版本 1: 无条带模式数 (对应字节为保留的 0); 版本 2: 增加 strip_patterns
+constexpr uint32_t kStoreVersion = 2;
+constexpr uint32_t kMinStoreVersion = 1;
+
+struct StoreHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+};
+
+// 定长记录 (小端, 72 字节)
+struct StoreRecord {
+    uint64_t key;
+    int32_t num_types;
+    int32_t actual_nodes;
+    double avg_size_ratio;
+    double avg_demand;
+    double size_cv;
+    double width_diversity;
+    double actual_gap;
+    double solve_time;
+    uint8_t timed_out;
+    uint8_t reserved[3];
+    float strip_patterns;   // 版本 2 起; 版本 1 记录中为保留的 0, 即模式因子不计入
+};
+
+static_assert(sizeof(StoreRecord) == 72, "StoreRecord layout");
+
+CalibrationPoint ToPoint(const StoreRecord& r) {
+    CalibrationPoint p;
+    p.num_types = r.num_types;
+    p.avg_size_ratio = r.avg_size_ratio;
+    p.avg_demand = r.avg_demand;
+    p.size_cv = r.size_cv;
+    p.width_diversity = r.width_diversity;
+    p.actual_gap = r.actual_gap;
+    p.actual_nodes = r.actual_nodes;
+    p.solve_time = r.solve_time;
+    p.timed_out = r.timed_out != 0;
+    p.strip_patterns = r.strip_patterns;
+    return p;
+}
+
+// 去除首尾空白
+std::string Trim(const std::string& s) {
+    size_t b = s.find_first_not_of(" \t\r");
+    if (b == std::string::npos) return std::string();
+    size_t e = s.find_last_not_of(" \t\r");
+    return s.substr(b, e - b + 1);
+}
+
+void SplitFields(const std::string& line, std::vector<std::string>& fields) {
+    fields.clear();
+    size_t start = 0;
+    for (;;) {
+        size_t comma = line.find(',', start);
+        fields.push_back(Trim(line.substr(start, comma - start)));
+        if (comma == std::string::npos) break;
+        start = comma + 1;
+    }
+}
+
+bool ParseDouble(const std::string& s, double& value) {
+    if (s.empty()) return false;
+    char* end = nullptr;
+    value = std::strtod(s.c_str(), &end);
+    // 允许百分数写法 (如 "5.2%")
+    if (*end == '%') {
+        value /= 100.0;
+        end++;
+    }
+    return *end == '\0';
+}
+
+bool ParseBool(const std::string& s, bool& value) {
+    if (s == "1" || s == "true" || s == "True" || s == "TRUE" || s == "yes") {
+        value = true;
+        return true;
+    }
+    if (s == "0" || s == "false" || s == "False" || s == "FALSE" || s == "no") {
+        value = false;
+        return true;
+    }
+    return false;
+}
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// CalibrationStore
+// ---------------------------------------------------------------------------
+
+std::string CalibrationStore::PathFor(const std::string& weights_path) {
+    return std::filesystem::path(weights_path).replace_extension(".points").string();
+}
+
+CalibrationStore::~CalibrationStore() {
+    if (append_file_) {
+        std::fclose(append_file_);
+    }
+}
+
+bool CalibrationStore::Open(const std::string& path) {
+    if (append_file_) {
+        std::fclose(append_file_);
+        append_file_ = nullptr;
+    }
+    path_ = path;
+    keys_.clear();
+    points_.clear();
+
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (file) {
+        StoreHeader header;
+        if (std::fread(&header, sizeof(header), 1, file) != 1 ||
+            std::memcmp(header.magic, kStoreMagic, sizeof(kStoreMagic)) != 0 ||
+            header.version < kMinStoreVersion || header.version > kStoreVersion ||
+            header.record_size != sizeof(StoreRecord)) {
+            std::fclose(file);
+            std::cerr << "Error: Invalid calibration store " << path << std::endl;
+            return false;
+        }
+        StoreRecord record;
+        while (std::fread(&record, sizeof(record), 1, file) == 1) {
+            if (keys_.insert(record.key).second) {
+                points_.push_back(ToPoint(record));
+            }
+        }
+        std::fclose(file);
+        // 版本 1 记录布局相同, 就地升级文件头, 之后追加的记录带条带模式数
+        if (header.version < kStoreVersion) {
+            header.version = kStoreVersion;
+            file = std::fopen(path.c_str(), "r+b");
+            bool ok = file && std::fwrite(&header, sizeof(header), 1, file) == 1;
+            ok = file && (std::fclose(file) == 0) && ok;
+            if (!ok) {
+                std::cerr << "Error: Cannot upgrade calibration store " << path << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // 新建存储
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Error: Cannot open file " << path << std::endl;
+        return false;
+    }
+    StoreHeader header{};
+    std::memcpy(header.magic, kStoreMagic, sizeof(kStoreMagic));
+    header.version = kStoreVersion;
+    header.record_size = sizeof(StoreRecord);
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = (std::fclose(file) == 0) && ok;
+    return ok;
+}
+
+bool CalibrationStore::Append(uint64_t key, const CalibrationPoint& point) {
+    if (!keys_.insert(key).second) return true;
+
+    StoreRecord record{};
+    record.key = key;
+    record.num_types = point.num_types;
+    record.actual_nodes = point.actual_nodes;
+    record.avg_size_ratio = point.avg_size_ratio;
+    record.avg_demand = point.avg_demand;
+    record.size_cv = point.size_cv;
+    record.width_diversity = point.width_diversity;
+    record.actual_gap = point.actual_gap;
+    record.solve_time = point.solve_time;
+    record.timed_out = point.timed_out ? 1 : 0;
+    record.strip_patterns = static_cast<float>(point.strip_patterns);
+
+    // 追加句柄在首次写入时打开, 整个导入过程复用
+    if (!append_file_) {
+        append_file_ = std::fopen(path_.c_str(), "ab");
+        if (!append_file_) {
+            keys_.erase(key);
+            std::cerr << "Error: Cannot open file " << path_ << std::endl;
+            return false;
+        }
+    }
+    bool ok = std::fwrite(&record, sizeof(record), 1, append_file_) == 1;
+    if (!ok) {
+        keys_.erase(key);
+        return false;
+    }
+    points_.push_back(point);
+    return true;
+}
+
+bool CalibrationStore::Flush() {
+    return !append_file_ || std::fflush(append_file_) == 0;
+}
+
+size_t CalibrationStore::LoadInto(DifficultyEstimator& estimator) const {
+    for (const auto& point : points_) {
+        estimator.AddCalibrationPoint(point);
+    }
+    return points_.size();
+}
+
+// ---------------------------------------------------------------------------
+// CalibrationLoader
+// ---------------------------------------------------------------------------
+
+uint64_t CalibrationLoader::KeyOf(const std::string& instance_path) {
+    // 以规范化的绝对路径计算: "a/./b.csv"、"a/b.csv" 以及从不同目录引用的同一文件得到同一键
+    std::error_code ec;
+    std::filesystem::path canonical = std::filesystem::weakly_canonical(instance_path, ec);
+    if (ec) canonical = std::filesystem::absolute(instance_path, ec).lexically_normal();
+    std::string name = canonical.generic_string();
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char c : name) {
+        hash ^= c;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+IngestSummary CalibrationLoader::IngestResults(const std::string& results_path,
+                                               CalibrationStore& store) {
+    IngestSummary summary;
+    std::ifstream file(results_path);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open file " << results_path << std::endl;
+        return summary;
+    }
+    const std::filesystem::path base_dir = std::filesystem::path(results_path).parent_path();
+
+    // 表头决定列位置; 列顺序任意, 未知列忽略
+    enum Column { kInstance, kGap, kNodes, kTime, kTimedOut, kNumColumns };
+    int column[kNumColumns] = {-1, -1, -1, -1, -1};
+    bool has_header = false;
+
+    CsvReader reader;
+    Instance inst;
+    std::vector<std::string> fields;
+    std::string line;
+    size_t line_no = 0;
+    while (std::getline(file, line)) {
+        line_no++;
+        std::string trimmed = Trim(line);
+        if (trimmed.empty() || trimmed[0] == '#') continue;
+        SplitFields(trimmed, fields);
+
+        if (!has_header) {
+            for (int i = 0; i < static_cast<int>(fields.size()); i++) {
+                const std::string& name = fields[i];
+                if (name == "instance_file" || name == "instance" || name == "file") column[kInstance] = i;
+                else if (name == "gap") column[kGap] = i;
+                else if (name == "nodes") column[kNodes] = i;
+                else if (name == "solve_time" || name == "time") column[kTime] = i;
+                else if (name == "timed_out" || name == "timeout") column[kTimedOut] = i;
+            }
+            if (column[kInstance] < 0 || column[kGap] < 0) {
+                std::cerr << "Error: " << results_path
+                          << ": header must contain instance_file and gap" << std::endl;
+                return summary;
+            }
+            has_header = true;
+            continue;
+        }
+
+        summary.rows++;
+        auto field = [&](Column c) -> const std::string& {
+            static const std::string kEmpty;
+            return (column[c] >= 0 && column[c] < static_cast<int>(fields.size()))
+                ? fields[column[c]] : kEmpty;
+        };
+
+        // 解析算例路径, 已入库的算例不再读取
+        std::filesystem::path instance_path(field(kInstance));
+        if (instance_path.is_relative() && !std::filesystem::exists(instance_path)) {
+            instance_path = base_dir / instance_path;
+        }
+        uint64_t key = KeyOf(instance_path.string());
+        if (store.Contains(key)) {
+            summary.skipped++;
+            continue;
+        }
+
+        CalibrationPoint point{};
+        double nodes = 0.0;
+        bool ok = ParseDouble(field(kGap), point.actual_gap);
+        if (ok && column[kNodes] >= 0) ok = ParseDouble(field(kNodes), nodes);
+        if (ok && column[kTime] >= 0) ok = ParseDouble(field(kTime), point.solve_time);
+        if (ok && column[kTimedOut] >= 0) ok = ParseBool(field(kTimedOut), point.timed_out);
+        if (!ok) {
+            std::cerr << "Error: " << results_path << " line " << line_no
+                      << ": bad result fields" << std::endl;
+            summary.failed++;
+            continue;
+        }
+        point.actual_nodes = static_cast<int>(nodes);
+
+        if (!reader.Read(instance_path.string(), inst)) {
+            std::cerr << "Error: Cannot import " << instance_path.string() << " ("
+                      << reader.Error() << ")" << std::endl;
+            summary.failed++;
+            continue;
+        }
+        const InstanceStats& stats = inst.Stats();
+        point.num_types = stats.num_types;
+        point.avg_size_ratio = stats.AvgSizeRatio();
+        point.avg_demand = stats.AvgDemand();
+        point.size_cv = stats.SizeCV();
+        point.width_diversity = stats.WidthDiversity();
+        point.strip_patterns = DifficultyEstimator::CountStripPatterns(inst);
+
+        if (store.Append(key, point)) {
+            summary.added++;
+        } else {
+            summary.failed++;
+        }
+    }
+    store.Flush();
+    return summary;
+}
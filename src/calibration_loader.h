@@ -0,0 +1,76 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// calibration_loader.h - 校准数据批量导入
+// 流式读取求解器结果文件 (instance_file, gap, nodes, solve_time, timed_out),
+// 逐行导入对应算例提取特征, 追加到与权重文件并列的二进制特征存储;
+// 已在存储中的算例直接跳过, 增量校准只需处理新增行
+
+#ifndef CS_2D_DATA_CALIBRATION_LOADER_H_
+#define CS_2D_DATA_CALIBRATION_LOADER_H_
+
+#include "difficulty_estimator.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// 追加式校准特征存储 (定长记录, 以算例路径哈希为键去重)
+class CalibrationStore {
+public:
+    CalibrationStore() = default;
+    ~CalibrationStore();
+
+    CalibrationStore(const CalibrationStore&) = delete;
+    CalibrationStore& operator=(const CalibrationStore&) = delete;
+
+    // 权重文件对应的存储路径 (扩展名替换为 .points)
+    static std::string PathFor(const std::string& weights_path);
+
+    // 打开存储 (不存在则创建), 读入已有记录
+    bool Open(const std::string& path);
+
+    bool Contains(uint64_t key) const { return keys_.count(key) > 0; }
+
+    // 追加一条记录 (键已存在时忽略)
+    bool Append(uint64_t key, const CalibrationPoint& point);
+
+    // 刷新已追加的记录到文件
+    bool Flush();
+
+    // 将全部记录加入预估器, 返回记录数
+    size_t LoadInto(DifficultyEstimator& estimator) const;
+
+    size_t Size() const { return points_.size(); }
+
+private:
+    std::string path_;
+    std::FILE* append_file_ = nullptr;
+    std::unordered_set<uint64_t> keys_;
+    std::vector<CalibrationPoint> points_;
+};
+
+// 求解结果文件导入统计
+struct IngestSummary {
+    size_t rows = 0;            // 数据行数
+    size_t added = 0;           // 新增记录
+    size_t skipped = 0;         // 已在存储中
+    size_t failed = 0;          // 格式错误或算例缺失
+};
+
+class CalibrationLoader {
+public:
+    // 算例路径的存储键 (规范化绝对路径的 FNV-1a)
+    static uint64_t KeyOf(const std::string& instance_path);
+
+    // 流式导入结果文件; 相对算例路径先按当前目录解析, 不存在时按结果文件所在目录解析
+    static IngestSummary IngestResults(const std::string& results_path, CalibrationStore& store);
+};
+
+#endif  // CS_2D_DATA_CALIBRATION_LOADER_H_
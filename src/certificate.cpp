@@ -0,0 +1,82 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// certificate.cpp - 两阶段装箱证书校验实现
+
+#include "certificate.h"
+#include "instance.h"
+
+std::string CertificatePath(const std::string& instance_path) {
+    static constexpr char kExt[] = ".csv";
+    constexpr size_t kExtLen = sizeof(kExt) - 1;
+    if (instance_path.size() >= kExtLen &&
+        instance_path.compare(instance_path.size() - kExtLen, kExtLen, kExt) == 0) {
+        return instance_path.substr(0, instance_path.size() - kExtLen) + ".cert.csv";
+    }
+    return instance_path + ".cert.csv";
+}
+
+bool VerifyCertificate(const Instance& inst, const PackingCertificate& cert, std::string& error) {
+    const int num_strips = cert.NumStrips();
+    if (cert.stock_begin.empty() || cert.stock_begin.front() != 0 ||
+        cert.stock_begin.back() != num_strips ||
+        static_cast<int>(cert.strip_begin.size()) != num_strips + 1 ||
+        cert.strip_begin.front() != 0 ||
+        cert.strip_begin.back() != static_cast<int>(cert.piece_ids.size())) {
+        error = "inconsistent certificate layout";
+        return false;
+    }
+
+    // 子板编号即其在列表中的位置 (导出与导入均保证)
+    const int n = inst.NumTypes();
+    std::vector<int> produced(n, 0);
+
+    for (int s = 0; s < cert.NumStocks(); s++) {
+        long long used_width = 0;
+        for (int k = cert.stock_begin[s]; k < cert.stock_begin[s + 1]; k++) {
+            const int strip_width = cert.strip_width[k];
+            used_width += strip_width;
+            long long used_length = 0;
+            for (int p = cert.strip_begin[k]; p < cert.strip_begin[k + 1]; p++) {
+                const int id = cert.piece_ids[p];
+                if (id < 0 || id >= n || inst.items[id].id != id) {
+                    error = "stock " + std::to_string(s) + ": unknown item id " +
+                            std::to_string(id);
+                    return false;
+                }
+                const Item& item = inst.items[id];
+                if (item.width > strip_width) {
+                    error = "stock " + std::to_string(s) + ": item " + std::to_string(id) +
+                            " wider than strip " + std::to_string(strip_width);
+                    return false;
+                }
+                used_length += item.length;
+                produced[id]++;
+            }
+            if (used_length > inst.stock_length) {
+                error = "stock " + std::to_string(s) + ": strip length " +
+                        std::to_string(used_length) + " exceeds stock length";
+                return false;
+            }
+        }
+        if (used_width > inst.stock_width) {
+            error = "stock " + std::to_string(s) + ": strip widths " +
+                    std::to_string(used_width) + " exceed stock width";
+            return false;
+        }
+    }
+
+    for (int i = 0; i < n; i++) {
+        if (produced[i] < inst.items[i].demand) {
+            error = "item " + std::to_string(i) + ": produced " + std::to_string(produced[i]) +
+                    " < demand " + std::to_string(inst.items[i].demand);
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,60 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// certificate.h - 两阶段装箱证书 (母板 -> 条带宽度 -> 子板列表)
+// 逆向生成在构造算例时得到一个完美填充, 以证书形式保留, 供求解器作为初始列与原始界,
+// 也可用于 O(n) 校验求解结果而无需重新求解
+
+#ifndef CS_2D_DATA_CERTIFICATE_H_
+#define CS_2D_DATA_CERTIFICATE_H_
+
+#include <string>
+#include <vector>
+
+struct Instance;
+
+// 扁平存储: 第 s 块母板的条带为 [stock_begin[s], stock_begin[s+1]),
+// 第 k 条条带的子板为 piece_ids[strip_begin[k] .. strip_begin[k+1])
+struct PackingCertificate {
+    std::vector<int> stock_begin = {0};     // 每块母板的首条带序号 (大小 = 母板数 + 1)
+    std::vector<int> strip_width;           // 条带宽度
+    std::vector<int> strip_begin = {0};     // 每条条带的首子板位置 (大小 = 条带数 + 1)
+    std::vector<int> piece_ids;             // 子板类型编号
+
+    int NumStocks() const { return static_cast<int>(stock_begin.size()) - 1; }
+    int NumStrips() const { return static_cast<int>(strip_width.size()); }
+    bool Empty() const { return NumStocks() == 0; }
+
+    void Clear() {
+        stock_begin.assign(1, 0);
+        strip_width.clear();
+        strip_begin.assign(1, 0);
+        piece_ids.clear();
+    }
+
+    // 逐步构造: 开启条带 -> 放入子板 -> 结束母板
+    void AddStrip(int width) {
+        strip_width.push_back(width);
+        strip_begin.push_back(strip_begin.back());
+    }
+    void AddPiece(int id) {
+        piece_ids.push_back(id);
+        strip_begin.back()++;
+    }
+    void CloseStock() { stock_begin.push_back(NumStrips()); }
+};
+
+// 证书文件路径: inst_xxx.csv -> inst_xxx.cert.csv
+std::string CertificatePath(const std::string& instance_path);
+
+// 校验证书是否为算例的可行两阶段切割方案 (单遍, O(子板数 + 条带数 + 类型数)):
+// 条带宽度之和不超过母板宽度, 子板宽度不超过所在条带宽度, 条带内长度之和不超过母板长度,
+// 每种子板的产出不少于需求. 失败时 error 给出原因
+bool VerifyCertificate(const Instance& inst, const PackingCertificate& cert, std::string& error);
+
+#endif  // CS_2D_DATA_CERTIFICATE_H_
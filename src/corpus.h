@@ -0,0 +1,221 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// corpus.h - 二进制语料格式与内存映射读取器 (仅头文件)
+//
+// 文件布局 (小端, 所有字段自然对齐, 记录按8字节对齐):
+//   CorpusHeader
+//   记录 0..n-1 (按写出顺序, 不一定按序号)
+//     CorpusRecord
+//     int32 width[num_types]  int32 length[num_types]  int32 demand[num_types]
+//     (填充至8字节)
+//   uint64 offsets[num_instances]   (按批次序号索引, 0 = 该序号生成失败)
+//
+// 子板 id 即其在数组中的位置 (与 ValidateAndFix 的编号一致), 不单独存储。
+
+#ifndef CS_2D_DATA_CORPUS_H_
+#define CS_2D_DATA_CORPUS_H_
+
+#include "instance.h"
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+constexpr char kCorpusMagic[8] = {'C', 'S', '2', 'D', 'C', 'O', 'R', 'P'};
+constexpr uint32_t kCorpusVersion = 1;
+
+struct CorpusHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t num_instances;         // 偏移表条目数 (= 批次算例数)
+    uint64_t offset_table;          // 偏移表的文件偏移
+    uint64_t base_seed;             // 批次基础种子
+};
+
+struct CorpusRecord {
+    int32_t stock_width;
+    int32_t stock_length;
+    int32_t known_optimal;
+    int32_t num_types;
+    double difficulty;              // 生成参数中的难度
+    double score;                   // 预估难度评分
+    uint64_t index;                 // 批次内序号
+};
+
+static_assert(sizeof(CorpusHeader) == 40, "CorpusHeader layout");
+static_assert(sizeof(CorpusRecord) == 40, "CorpusRecord layout");
+
+// 单条记录的字节数 (含SoA列与对齐填充)
+inline uint64_t CorpusRecordSize(int num_types) {
+    uint64_t size = sizeof(CorpusRecord) + 3ULL * sizeof(int32_t) * num_types;
+    return (size + 7) & ~7ULL;
+}
+
+// 语料中一个算例的零拷贝视图, 指针指向映射内存, 读取器关闭后失效
+struct InstanceView {
+    const CorpusRecord* record = nullptr;
+    const int32_t* widths = nullptr;
+    const int32_t* lengths = nullptr;
+    const int32_t* demands = nullptr;
+
+    bool Valid() const { return record != nullptr; }
+    int NumTypes() const { return record->num_types; }
+    int StockWidth() const { return record->stock_width; }
+    int StockLength() const { return record->stock_length; }
+
+    // 复制为可修改的 Instance
+    Instance ToInstance() const {
+        Instance inst;
+        inst.stock_width = record->stock_width;
+        inst.stock_length = record->stock_length;
+        inst.known_optimal = record->known_optimal;
+        inst.difficulty = record->difficulty;
+        inst.items.resize(record->num_types);
+        for (int i = 0; i < record->num_types; i++) {
+            inst.items[i] = Item{i, widths[i], lengths[i], demands[i]};
+        }
+        inst.RefreshStats();
+        return inst;
+    }
+};
+
+// 内存映射读取器: Open 只校验文件头与偏移表, 访问第k个算例为 O(1)
+class CorpusReader {
+public:
+    CorpusReader() = default;
+    ~CorpusReader() { Close(); }
+
+    CorpusReader(const CorpusReader&) = delete;
+    CorpusReader& operator=(const CorpusReader&) = delete;
+
+    bool Open(const std::string& path) {
+        Close();
+        if (!Map(path)) return false;
+
+        if (size_ < sizeof(CorpusHeader)) return Fail("file too small");
+        header_ = reinterpret_cast<const CorpusHeader*>(data_);
+        if (std::memcmp(header_->magic, kCorpusMagic, sizeof(kCorpusMagic)) != 0) {
+            return Fail("bad magic");
+        }
+        if (header_->version != kCorpusVersion) return Fail("unsupported version");
+        if (header_->offset_table % 8 != 0 || header_->offset_table > size_ ||
+            header_->num_instances > (size_ - header_->offset_table) / sizeof(uint64_t)) {
+            return Fail("offset table out of range");
+        }
+        offsets_ = reinterpret_cast<const uint64_t*>(data_ + header_->offset_table);
+        return true;
+    }
+
+    void Close() {
+        if (data_) {
+#ifdef _WIN32
+            UnmapViewOfFile(data_);
+#else
+            munmap(const_cast<unsigned char*>(data_), size_);
+#endif
+        }
+        data_ = nullptr;
+        size_ = 0;
+        header_ = nullptr;
+        offsets_ = nullptr;
+    }
+
+    bool IsOpen() const { return header_ != nullptr; }
+    const std::string& Error() const { return error_; }
+
+    uint64_t Size() const { return header_ ? header_->num_instances : 0; }
+    uint64_t BaseSeed() const { return header_ ? header_->base_seed : 0; }
+
+    // 第k个算例是否存在 (生成失败的序号为空)
+    bool Has(uint64_t k) const { return k < Size() && offsets_[k] != 0; }
+
+    // 第k个算例的视图; 不存在或记录越界时返回无效视图
+    InstanceView Get(uint64_t k) const {
+        InstanceView view;
+        if (!Has(k)) return view;
+        uint64_t offset = offsets_[k];
+        if (offset % 8 != 0 || offset > header_->offset_table ||
+            header_->offset_table - offset < sizeof(CorpusRecord)) {
+            return view;
+        }
+        const auto* record = reinterpret_cast<const CorpusRecord*>(data_ + offset);
+        if (record->num_types < 0 ||
+            CorpusRecordSize(record->num_types) > header_->offset_table - offset) {
+            return view;
+        }
+        const auto* columns = reinterpret_cast<const int32_t*>(record + 1);
+        view.record = record;
+        view.widths = columns;
+        view.lengths = columns + record->num_types;
+        view.demands = columns + 2 * record->num_types;
+        return view;
+    }
+
+private:
+    const unsigned char* data_ = nullptr;
+    uint64_t size_ = 0;
+    const CorpusHeader* header_ = nullptr;
+    const uint64_t* offsets_ = nullptr;
+    std::string error_;
+
+    bool Fail(const char* message) {
+        Close();
+        error_ = message;
+        return false;
+    }
+
+    bool Map(const std::string& path) {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return Fail("cannot open file");
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+            CloseHandle(file);
+            return Fail("cannot stat file");
+        }
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping) return Fail("cannot map file");
+        void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        if (!data) return Fail("cannot map file");
+        data_ = static_cast<const unsigned char*>(data);
+        size_ = static_cast<uint64_t>(file_size.QuadPart);
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return Fail("cannot open file");
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+            close(fd);
+            return Fail("cannot stat file");
+        }
+        void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) return Fail("cannot map file");
+        data_ = static_cast<const unsigned char*>(data);
+        size_ = static_cast<uint64_t>(st.st_size);
+#endif
+        return true;
+    }
+};
+
+#endif  // CS_2D_DATA_CORPUS_H_
@@ -0,0 +1,454 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// corpus_summary.cpp - 直方图, 分位数草图与语料汇总实现
+
+#include "corpus_summary.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+// 各指标的直方图范围 (超出范围计入下溢/上溢)
+struct MetricSpec {
+    const char* key;
+    double lo;
+    double hi;
+    int num_bins;
+};
+
+constexpr MetricSpec kMetricSpecs[CorpusSummary::kNumMetrics] = {
+    {"score", 0.0, 3.0, 30},
+    {"utilization_lb", 0.0, 1.0, 20},
+    {"size_cv", 0.0, 2.0, 20},
+    {"demand_cv", 0.0, 2.0, 20},
+};
+
+constexpr const char* kLevelKeys[CorpusSummary::kNumLevels] = {
+    "level_trivial", "level_easy", "level_medium", "level_hard", "level_very_hard",
+    "level_expert"
+};
+
+std::string Trim(const std::string& s) {
+    size_t b = s.find_first_not_of(" \t\r");
+    if (b == std::string::npos) return std::string();
+    size_t e = s.find_last_not_of(" \t\r");
+    return s.substr(b, e - b + 1);
+}
+
+// 往返精确的浮点格式
+std::string Real(double v) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.17g", v);
+    return buf;
+}
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// FixedHistogram
+
+FixedHistogram::FixedHistogram(double lo, double hi, int num_bins)
+    : lo_(lo), hi_(hi), scale_(num_bins / (hi - lo)), bins_(num_bins, 0) {}
+
+void FixedHistogram::Add(double x) {
+    if (x < lo_) {
+        underflow_++;
+    } else if (x >= hi_) {
+        overflow_++;
+    } else {
+        int bin = static_cast<int>((x - lo_) * scale_);
+        bins_[std::min(bin, NumBins() - 1)]++;
+    }
+}
+
+bool FixedHistogram::Merge(const FixedHistogram& other) {
+    if (other.lo_ != lo_ || other.hi_ != hi_ || other.bins_.size() != bins_.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < bins_.size(); i++) bins_[i] += other.bins_[i];
+    underflow_ += other.underflow_;
+    overflow_ += other.overflow_;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// QuantileSketch
+
+QuantileSketch::QuantileSketch(double alpha, int max_buckets)
+    : alpha_(alpha),
+      gamma_((1.0 + alpha) / (1.0 - alpha)),
+      log_gamma_(std::log(gamma_)),
+      max_buckets_(std::max(1, max_buckets)) {}
+
+void QuantileSketch::Add(double x) {
+    count_++;
+    if (!(x > kMinPositive)) {
+        zero_count_++;
+        return;
+    }
+    AddToBucket(static_cast<int>(std::ceil(std::log(x) / log_gamma_)), 1);
+}
+
+void QuantileSketch::AddToBucket(int index, uint64_t n) {
+    if (buckets_.empty()) {
+        offset_ = index;
+        buckets_.assign(1, 0);
+    }
+    const int top = offset_ + static_cast<int>(buckets_.size()) - 1;
+    if (index < offset_) {
+        // 低于现有范围: 受桶数上限约束时并入允许的最低桶
+        index = std::max(index, top - max_buckets_ + 1);
+        if (index < offset_) {
+            buckets_.insert(buckets_.begin(), offset_ - index, 0);
+            offset_ = index;
+        }
+    } else if (index > top) {
+        const int size = index - offset_ + 1;
+        if (size > max_buckets_) {
+            // 超出上限: 最低的若干桶并入其上方的桶
+            const int shift = size - max_buckets_;
+            const int kept = std::min(shift, static_cast<int>(buckets_.size()));
+            uint64_t folded = 0;
+            for (int i = 0; i < kept; i++) folded += buckets_[i];
+            buckets_.erase(buckets_.begin(), buckets_.begin() + kept);
+            offset_ += shift;
+            if (buckets_.empty()) buckets_.assign(1, 0);
+            buckets_[0] += folded;
+        }
+        buckets_.resize(index - offset_ + 1, 0);
+    }
+    buckets_[index - offset_] += n;
+}
+
+bool QuantileSketch::Merge(const QuantileSketch& other) {
+    if (other.alpha_ != alpha_) return false;
+    count_ += other.count_;
+    zero_count_ += other.zero_count_;
+    for (size_t i = 0; i < other.buckets_.size(); i++) {
+        if (other.buckets_[i] > 0) {
+            AddToBucket(other.offset_ + static_cast<int>(i), other.buckets_[i]);
+        }
+    }
+    return true;
+}
+
+double QuantileSketch::Quantile(double q) const {
+    if (count_ == 0) return 0.0;
+    const double rank = std::clamp(q, 0.0, 1.0) * static_cast<double>(count_ - 1);
+    uint64_t seen = zero_count_;
+    if (static_cast<double>(seen) > rank) return 0.0;
+    for (size_t i = 0; i < buckets_.size(); i++) {
+        seen += buckets_[i];
+        if (static_cast<double>(seen) > rank) {
+            // 桶 (gamma^(k-1), gamma^k] 的代表值, 相对误差 ≤ alpha
+            const int k = offset_ + static_cast<int>(i);
+            return 2.0 * std::exp(k * log_gamma_) / (gamma_ + 1.0);
+        }
+    }
+    return 2.0 * std::exp((offset_ + static_cast<int>(buckets_.size()) - 1) * log_gamma_) /
+           (gamma_ + 1.0);
+}
+
+// ---------------------------------------------------------------------------
+// MetricSummary
+
+void MetricSummary::Add(double x) {
+    if (count == 0) {
+        min = max = x;
+    } else {
+        min = std::min(min, x);
+        max = std::max(max, x);
+    }
+    count++;
+    double delta = x - mean;
+    mean += delta / static_cast<double>(count);
+    m2 += delta * (x - mean);
+    histogram.Add(x);
+    sketch.Add(x);
+}
+
+bool MetricSummary::CompatibleWith(const MetricSummary& other) const {
+    return histogram.Lo() == other.histogram.Lo() && histogram.Hi() == other.histogram.Hi() &&
+           histogram.NumBins() == other.histogram.NumBins() &&
+           sketch.Alpha() == other.sketch.Alpha();
+}
+
+bool MetricSummary::Merge(const MetricSummary& other) {
+    if (!CompatibleWith(other)) return false;
+    histogram.Merge(other.histogram);
+    sketch.Merge(other.sketch);
+    if (other.count == 0) return true;
+    if (count == 0) {
+        min = other.min;
+        max = other.max;
+    } else {
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+    }
+    const double n_a = static_cast<double>(count);
+    const double n_b = static_cast<double>(other.count);
+    const double n = n_a + n_b;
+    const double delta = other.mean - mean;
+    mean += delta * n_b / n;
+    m2 += other.m2 + delta * delta * n_a * n_b / n;
+    count += other.count;
+    return true;
+}
+
+double MetricSummary::StdDev() const {
+    return count > 1 ? std::sqrt(m2 / static_cast<double>(count - 1)) : 0.0;
+}
+
+double MetricSummary::Quantile(double q) const {
+    if (count == 0) return 0.0;
+    return std::clamp(sketch.Quantile(q), min, max);
+}
+
+// ---------------------------------------------------------------------------
+// CorpusSummary
+
+CorpusSummary::CorpusSummary() {
+    metrics_.reserve(kNumMetrics);
+    for (const MetricSpec& spec : kMetricSpecs) {
+        metrics_.emplace_back(spec.lo, spec.hi, spec.num_bins);
+    }
+}
+
+const char* CorpusSummary::MetricName(Metric metric) {
+    return kMetricSpecs[metric].key;
+}
+
+void CorpusSummary::Add(const InstanceStats& stats, double score, DifficultyLevel level,
+    double utilization_lb) {
+    count_++;
+    level_counts_[static_cast<int>(level)]++;
+    metrics_[kScore].Add(score);
+    metrics_[kUtilizationLb].Add(utilization_lb);
+    metrics_[kSizeCV].Add(stats.SizeCV());
+    metrics_[kDemandCV].Add(stats.DemandCV());
+}
+
+void CorpusSummary::Add(const GenerationResult& result) {
+    Add(result.instance.Stats(), result.estimate.score, result.estimate.level,
+        result.bounds.utilization_lb);
+}
+
+bool CorpusSummary::Merge(const CorpusSummary& other) {
+    for (int m = 0; m < kNumMetrics; m++) {
+        if (!metrics_[m].CompatibleWith(other.metrics_[m])) {
+            error_ = std::string("incompatible ") + kMetricSpecs[m].key + " configuration";
+            return false;
+        }
+    }
+    for (int m = 0; m < kNumMetrics; m++) {
+        metrics_[m].Merge(other.metrics_[m]);
+    }
+    count_ += other.count_;
+    for (int level = 0; level < kNumLevels; level++) {
+        level_counts_[level] += other.level_counts_[level];
+    }
+    return true;
+}
+
+void CorpusSummary::Print(std::ostream& out) const {
+    std::ostringstream ss;
+    ss << std::fixed;
+    ss << "语料汇总: " << count_ << " 个算例\n";
+    if (count_ == 0) {
+        out << ss.str();
+        return;
+    }
+
+    ss << "  难度等级:";
+    for (int level = 0; level < kNumLevels; level++) {
+        if (level_counts_[level] == 0) continue;
+        ss << " " << DifficultyEstimator::LevelName(static_cast<DifficultyLevel>(level))
+           << " " << level_counts_[level] << " (" << std::setprecision(1)
+           << 100.0 * level_counts_[level] / count_ << "%)";
+    }
+    ss << "\n";
+
+    static const double kQuantiles[] = {0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99};
+    ss << "  " << std::left << std::setw(14) << "metric" << std::right
+       << std::setw(9) << "mean" << std::setw(9) << "std" << std::setw(9) << "min";
+    for (double q : kQuantiles) {
+        ss << std::setw(8) << ("p" + std::to_string(static_cast<int>(q * 100 + 0.5)));
+    }
+    ss << std::setw(9) << "max" << "\n";
+    for (int m = 0; m < kNumMetrics; m++) {
+        const MetricSummary& metric = metrics_[m];
+        ss << "  " << std::left << std::setw(14) << kMetricSpecs[m].key << std::right
+           << std::setprecision(4) << std::setw(9) << metric.mean << std::setw(9)
+           << metric.StdDev() << std::setw(9) << metric.min;
+        for (double q : kQuantiles) ss << std::setw(8) << metric.Quantile(q);
+        ss << std::setw(9) << metric.max << "\n";
+    }
+
+    // 评分直方图 (只显示非空区间)
+    const FixedHistogram& hist = metrics_[kScore].histogram;
+    uint64_t peak = std::max(hist.Underflow(), hist.Overflow());
+    for (int b = 0; b < hist.NumBins(); b++) peak = std::max(peak, hist.Bin(b));
+    auto bar = [&](uint64_t n) {
+        return std::string(peak > 0 ? static_cast<size_t>(40.0 * n / peak + 0.5) : 0, '#');
+    };
+    ss << "  评分分布:\n" << std::setprecision(2);
+    if (hist.Underflow() > 0) {
+        ss << "    <" << std::setw(9) << hist.Lo() << std::setw(10) << hist.Underflow() << " "
+           << bar(hist.Underflow()) << "\n";
+    }
+    for (int b = 0; b < hist.NumBins(); b++) {
+        if (hist.Bin(b) == 0) continue;
+        ss << "    " << std::setw(4) << hist.BinLower(b) << "-" << std::setw(5)
+           << hist.BinLower(b + 1) << std::setw(10) << hist.Bin(b) << " " << bar(hist.Bin(b))
+           << "\n";
+    }
+    if (hist.Overflow() > 0) {
+        ss << "    >=" << std::setw(8) << hist.Hi() << std::setw(10) << hist.Overflow() << " "
+           << bar(hist.Overflow()) << "\n";
+    }
+    out << ss.str();
+}
+
+bool CorpusSummary::Save(const std::string& filepath) const {
+    std::ofstream file(filepath);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open file " << filepath << std::endl;
+        return false;
+    }
+    file << "# CS-2D-Data corpus summary\n";
+    file << "format = " << kFormatVersion << "\n";
+    file << "count = " << count_ << "\n";
+    for (int level = 0; level < kNumLevels; level++) {
+        file << kLevelKeys[level] << " = " << level_counts_[level] << "\n";
+    }
+    for (int m = 0; m < kNumMetrics; m++) {
+        const MetricSummary& metric = metrics_[m];
+        const std::string key = kMetricSpecs[m].key;
+        file << key << ".moments = " << metric.count << " " << Real(metric.min) << " "
+             << Real(metric.max) << " " << Real(metric.mean) << " " << Real(metric.m2) << "\n";
+
+        const FixedHistogram& hist = metric.histogram;
+        file << key << ".hist = " << Real(hist.lo_) << " " << Real(hist.hi_) << " "
+             << hist.bins_.size() << " " << hist.underflow_ << " " << hist.overflow_;
+        for (uint64_t n : hist.bins_) file << " " << n;
+        file << "\n";
+
+        const QuantileSketch& sketch = metric.sketch;
+        file << key << ".sketch = " << Real(sketch.alpha_) << " " << sketch.max_buckets_ << " "
+             << sketch.zero_count_ << " " << sketch.offset_;
+        for (uint64_t n : sketch.buckets_) file << " " << n;
+        file << "\n";
+    }
+    file.close();
+    if (!file) {
+        std::cerr << "Error: Failed to write file " << filepath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool CorpusSummary::Load(const std::string& filepath) {
+    *this = CorpusSummary();
+    std::ifstream file(filepath);
+    if (!file.is_open()) {
+        error_ = "cannot open file";
+        return false;
+    }
+
+    bool has_format = false;
+    std::string line;
+    int line_no = 0;
+    while (std::getline(file, line)) {
+        line_no++;
+        std::string text = Trim(line);
+        if (text.empty() || text[0] == '#') continue;
+        size_t eq = text.find('=');
+        if (eq == std::string::npos) {
+            error_ = "line " + std::to_string(line_no) + ": expected key = value";
+            return false;
+        }
+        std::string key = Trim(text.substr(0, eq));
+        std::istringstream value(text.substr(eq + 1));
+
+        bool ok = true;
+        if (key == "format") {
+            int version = 0;
+            ok = (value >> version) && version == kFormatVersion;
+            has_format = ok;
+        } else if (key == "count") {
+            ok = static_cast<bool>(value >> count_);
+        } else {
+            auto level = std::find(std::begin(kLevelKeys), std::end(kLevelKeys), key);
+            size_t dot = key.rfind('.');
+            int m = 0;
+            if (level != std::end(kLevelKeys)) {
+                ok = static_cast<bool>(value >> level_counts_[level - std::begin(kLevelKeys)]);
+            } else if (dot != std::string::npos) {
+                const std::string name = key.substr(0, dot);
+                const std::string field = key.substr(dot + 1);
+                while (m < kNumMetrics && name != kMetricSpecs[m].key) m++;
+                ok = m < kNumMetrics;
+                if (ok && field == "moments") {
+                    MetricSummary& metric = metrics_[m];
+                    ok = static_cast<bool>(value >> metric.count >> metric.min >> metric.max >>
+                                           metric.mean >> metric.m2);
+                } else if (ok && field == "hist") {
+                    double lo = 0.0, hi = 0.0;
+                    size_t num_bins = 0;
+                    FixedHistogram& hist = metrics_[m].histogram;
+                    ok = (value >> lo >> hi >> num_bins >> hist.underflow_ >> hist.overflow_) &&
+                         num_bins > 0 && hi > lo && num_bins <= (1u << 20);
+                    if (ok) {
+                        const uint64_t underflow = hist.underflow_, overflow = hist.overflow_;
+                        hist = FixedHistogram(lo, hi, static_cast<int>(num_bins));
+                        hist.underflow_ = underflow;
+                        hist.overflow_ = overflow;
+                        for (uint64_t& n : hist.bins_) ok = ok && (value >> n);
+                    }
+                } else if (ok && field == "sketch") {
+                    double alpha = 0.0;
+                    int max_buckets = 0;
+                    QuantileSketch& sketch = metrics_[m].sketch;
+                    ok = (value >> alpha) && alpha > 0.0 && alpha < 1.0 &&
+                         (value >> max_buckets) && max_buckets > 0;
+                    if (ok) {
+                        sketch = QuantileSketch(alpha, max_buckets);
+                        ok = static_cast<bool>(value >> sketch.zero_count_ >> sketch.offset_);
+                        sketch.count_ = sketch.zero_count_;
+                        uint64_t n = 0;
+                        while (ok && value >> n) {
+                            sketch.buckets_.push_back(n);
+                            sketch.count_ += n;
+                        }
+                        ok = ok && static_cast<int>(sketch.buckets_.size()) <= max_buckets;
+                    }
+                } else {
+                    ok = false;
+                }
+            } else {
+                ok = false;
+            }
+        }
+        if (!ok) {
+            error_ = "line " + std::to_string(line_no) + ": bad value for " + key;
+            return false;
+        }
+    }
+    if (!has_format) {
+        error_ = "missing format";
+        return false;
+    }
+    return true;
+}
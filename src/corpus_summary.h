@@ -0,0 +1,152 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// corpus_summary.h - 语料级难度分布的流式汇总
+// 每个工作线程持有一份 CorpusSummary, 逐个算例累加 (不保存算例), 结束时合并;
+// 内存与语料规模无关. 汇总可保存为文本文件, 多节点分片的汇总文件合并后与整批汇总一致
+// (直方图与计数精确一致, 分位数草图的桶计数一致, 均值/方差仅有浮点舍入差异)
+//
+// 文本格式 (key = value, '#' 注释):
+//   format = 1
+//   count = 1000000
+//   level_trivial = 12 ... level_expert = 3
+//   score.moments = count min max mean m2
+//   score.hist = lo hi num_bins underflow overflow c0 c1 ...
+//   score.sketch = alpha max_buckets zero_count offset c0 c1 ...
+//   (utilization_lb / size_cv / demand_cv 同上)
+
+#ifndef CS_2D_DATA_CORPUS_SUMMARY_H_
+#define CS_2D_DATA_CORPUS_SUMMARY_H_
+
+#include "difficulty_estimator.h"
+#include "generator.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// 定宽直方图 [lo, hi), 另计下溢/上溢; 配置相同才可合并
+class FixedHistogram {
+public:
+    FixedHistogram(double lo, double hi, int num_bins);
+
+    void Add(double x);
+    bool Merge(const FixedHistogram& other);
+
+    double Lo() const { return lo_; }
+    double Hi() const { return hi_; }
+    int NumBins() const { return static_cast<int>(bins_.size()); }
+    double BinLower(int bin) const { return lo_ + bin * (hi_ - lo_) / bins_.size(); }
+    uint64_t Bin(int bin) const { return bins_[bin]; }
+    uint64_t Underflow() const { return underflow_; }
+    uint64_t Overflow() const { return overflow_; }
+
+private:
+    friend class CorpusSummary;     // 文本读写
+
+    double lo_;
+    double hi_;
+    double scale_;                  // num_bins / (hi - lo)
+    std::vector<uint64_t> bins_;
+    uint64_t underflow_ = 0;
+    uint64_t overflow_ = 0;
+};
+
+// 相对误差分位数草图 (DDSketch): 正值按 gamma = (1+alpha)/(1-alpha) 的对数桶计数,
+// 任意分位数的相对误差不超过 alpha; 接近 0 的值单独计数. 桶数超过上限时把最低的桶合并,
+// 只损失最低分位数的精度. 同 alpha 的草图可合并; 未触及桶数上限时与逐个累加全部值的结果相同
+class QuantileSketch {
+public:
+    explicit QuantileSketch(double alpha = 0.01, int max_buckets = 2048);
+
+    void Add(double x);
+    bool Merge(const QuantileSketch& other);
+
+    // q ∈ [0, 1]; 空草图返回 0
+    double Quantile(double q) const;
+    uint64_t Count() const { return count_; }
+    double Alpha() const { return alpha_; }
+
+private:
+    friend class CorpusSummary;     // 文本读写
+
+    static constexpr double kMinPositive = 1e-9;     // 不大于此值计为 0
+
+    void AddToBucket(int index, uint64_t n);
+
+    double alpha_;
+    double gamma_;
+    double log_gamma_;
+    int max_buckets_;
+    uint64_t count_ = 0;
+    uint64_t zero_count_ = 0;
+    int offset_ = 0;                // buckets_[0] 的桶序号
+    std::vector<uint64_t> buckets_;
+};
+
+// 单个指标的汇总: 矩 (Welford, 按 Chan 公式合并) + 直方图 + 分位数草图
+struct MetricSummary {
+    uint64_t count = 0;
+    double min = 0.0;
+    double max = 0.0;
+    double mean = 0.0;
+    double m2 = 0.0;
+    FixedHistogram histogram;
+    QuantileSketch sketch;
+
+    MetricSummary(double lo, double hi, int num_bins) : histogram(lo, hi, num_bins) {}
+
+    void Add(double x);
+    // 直方图配置与草图精度相同才可合并
+    bool CompatibleWith(const MetricSummary& other) const;
+    bool Merge(const MetricSummary& other);
+
+    double StdDev() const;
+    // 分位数 (限制在 [min, max] 内)
+    double Quantile(double q) const;
+};
+
+class CorpusSummary {
+public:
+    static constexpr int kFormatVersion = 1;
+    static constexpr int kNumLevels = static_cast<int>(DifficultyLevel::kExpert) + 1;
+
+    enum Metric { kScore, kUtilizationLb, kSizeCV, kDemandCV, kNumMetrics };
+
+    CorpusSummary();
+
+    // utilization_lb 为组合利用率下界 (BoundReport::utilization_lb)
+    void Add(const InstanceStats& stats, double score, DifficultyLevel level,
+             double utilization_lb);
+    void Add(const GenerationResult& result);
+
+    // 合并另一份汇总 (另一节点/线程); 配置不一致返回 false
+    bool Merge(const CorpusSummary& other);
+
+    uint64_t Count() const { return count_; }
+    uint64_t LevelCount(DifficultyLevel level) const {
+        return level_counts_[static_cast<int>(level)];
+    }
+    const MetricSummary& Get(Metric metric) const { return metrics_[metric]; }
+    static const char* MetricName(Metric metric);
+
+    // 汇总报告: 等级分布, 各指标的均值/分位数, 评分直方图
+    void Print(std::ostream& out) const;
+
+    bool Save(const std::string& filepath) const;
+    bool Load(const std::string& filepath);
+    const std::string& Error() const { return error_; }
+
+private:
+    uint64_t count_ = 0;
+    uint64_t level_counts_[kNumLevels] = {};
+    std::vector<MetricSummary> metrics_;
+    std::string error_;
+};
+
+#endif  // CS_2D_DATA_CORPUS_SUMMARY_H_
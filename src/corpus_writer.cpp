@@ -0,0 +1,109 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// corpus_writer.cpp - 二进制语料写出实现
+
+#include "corpus_writer.h"
+#include "corpus.h"
+#include "csv_io.h"
+#include <cstring>
+#include <iostream>
+
+void EncodeCorpusRecord(uint64_t index, const Instance& inst, double score,
+                        std::vector<unsigned char>& out) {
+    const int n = static_cast<int>(inst.items.size());
+    out.assign(CorpusRecordSize(n), 0);
+
+    CorpusRecord record{};
+    record.stock_width = inst.stock_width;
+    record.stock_length = inst.stock_length;
+    record.known_optimal = inst.known_optimal;
+    record.num_types = n;
+    record.difficulty = inst.difficulty;
+    record.score = score;
+    record.index = index;
+    std::memcpy(out.data(), &record, sizeof(record));
+
+    // SoA 列: width[], length[], demand[]
+    auto* columns = out.data() + sizeof(record);
+    for (int i = 0; i < n; i++) {
+        const Item& item = inst.items[i];
+        int32_t w = item.width, l = item.length, d = item.demand;
+        std::memcpy(columns + sizeof(int32_t) * i, &w, sizeof(w));
+        std::memcpy(columns + sizeof(int32_t) * (n + i), &l, sizeof(l));
+        std::memcpy(columns + sizeof(int32_t) * (2 * n + i), &d, sizeof(d));
+    }
+}
+
+CorpusWriter::~CorpusWriter() {
+    if (file_) {
+        Finish();
+    }
+}
+
+bool CorpusWriter::Open(const std::string& path, uint64_t num_instances, uint64_t base_seed) {
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) {
+        std::cerr << "Error: Cannot open file " << path << std::endl;
+        return false;
+    }
+    path_ = path;
+    base_seed_ = base_seed;
+    offsets_.assign(num_instances, 0);
+    num_written_ = 0;
+
+    // 先写占位文件头, Finish 时回填
+    CorpusHeader header{};
+    position_ = sizeof(header);
+    return std::fwrite(&header, sizeof(header), 1, file_) == 1;
+}
+
+bool CorpusWriter::Append(uint64_t index, const Instance& inst, double score) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_ || index >= offsets_.size()) return false;
+
+    EncodeCorpusRecord(index, inst, score, buffer_);
+    const uint64_t size = buffer_.size();
+    if (std::fwrite(buffer_.data(), 1, size, file_) != size) {
+        std::cerr << "Error: Failed to write corpus " << path_ << std::endl;
+        return false;
+    }
+    offsets_[index] = position_;
+    position_ += size;
+    num_written_++;
+    return true;
+}
+
+bool CorpusWriter::Finish(bool sync) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_) return false;
+
+    CorpusHeader header{};
+    std::memcpy(header.magic, kCorpusMagic, sizeof(kCorpusMagic));
+    header.version = kCorpusVersion;
+    header.num_instances = offsets_.size();
+    header.offset_table = position_;
+    header.base_seed = base_seed_;
+
+    bool ok = offsets_.empty() ||
+              std::fwrite(offsets_.data(), sizeof(uint64_t), offsets_.size(), file_) ==
+                  offsets_.size();
+    ok = ok && std::fseek(file_, 0, SEEK_SET) == 0;
+    ok = ok && std::fwrite(&header, sizeof(header), 1, file_) == 1;
+    ok = ok && std::fflush(file_) == 0;
+    if (sync) {
+        ok = CsvSerializer::SyncAndClose(file_) && ok;
+    } else {
+        ok = (std::fclose(file_) == 0) && ok;
+    }
+    file_ = nullptr;
+    if (!ok) {
+        std::cerr << "Error: Failed to finalize corpus " << path_ << std::endl;
+    }
+    return ok;
+}
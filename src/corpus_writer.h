@@ -0,0 +1,56 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// corpus_writer.h - 二进制语料写出 (格式见 corpus.h)
+// 记录按到达顺序追加, 结束时写出偏移表并回填文件头, 全程单遍顺序写
+
+#ifndef CS_2D_DATA_CORPUS_WRITER_H_
+#define CS_2D_DATA_CORPUS_WRITER_H_
+
+#include "instance.h"
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// 将算例编码为一条语料记录 (CorpusRecord + SoA 列 + 对齐填充), 写入 out
+void EncodeCorpusRecord(uint64_t index, const Instance& inst, double score,
+                        std::vector<unsigned char>& out);
+
+class CorpusWriter {
+public:
+    CorpusWriter() = default;
+    ~CorpusWriter();
+
+    CorpusWriter(const CorpusWriter&) = delete;
+    CorpusWriter& operator=(const CorpusWriter&) = delete;
+
+    // 创建语料文件, num_instances 为偏移表条目数
+    bool Open(const std::string& path, uint64_t num_instances, uint64_t base_seed);
+
+    // 追加第index个算例 (线程安全)
+    bool Append(uint64_t index, const Instance& inst, double score);
+
+    // 写出偏移表并回填文件头; sync 为真时 fsync 落盘
+    bool Finish(bool sync = false);
+
+    uint64_t NumWritten() const { return num_written_; }
+
+private:
+    std::mutex mutex_;
+    std::FILE* file_ = nullptr;
+    std::string path_;
+    uint64_t base_seed_ = 0;
+    uint64_t position_ = 0;
+    uint64_t num_written_ = 0;
+    std::vector<uint64_t> offsets_;
+    std::vector<unsigned char> buffer_;     // 单条记录的序列化缓冲区
+};
+
+#endif  // CS_2D_DATA_CORPUS_WRITER_H_
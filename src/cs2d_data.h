@@ -0,0 +1,39 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// cs2d_data.h - cs2d_data_core 库的公共头文件
+// 求解器等调用方链接 cs2d_data_core 并只包含本文件, 即可在同一进程内生成并直接使用算例, 无需经过 CSV 文件:
+//
+//   InstanceGenerator generator(seed);
+//   GenerationResult result;
+//   for (uint64_t k = 0; k < n; k++) {
+//       if (!generator.GenerateInto(params, k, result)) continue;   // 复用 result 的内存
+//       ItemsView items = result.instance.Items();                  // 借用, 不拷贝
+//       Solve(items.data, items.size, items.stock_width, items.stock_length);
+//   }
+//
+// InstanceGenerator 实例不可跨线程共享, 每个线程各用一个 (第k个算例与线程无关)
+
+#ifndef CS_2D_DATA_CS2D_DATA_H_
+#define CS_2D_DATA_CS2D_DATA_H_
+
+#include "instance.h"
+#include "generator.h"
+#include "difficulty_estimator.h"
+#include "fingerprint.h"
+#include "incremental_stats.h"
+#include "instrumentation.h"
+#include "lower_bounds.h"
+#include "certificate.h"
+#include "csv_io.h"
+#include "corpus.h"
+#include "corpus_writer.h"
+#include "corpus_summary.h"
+#include "virtual_corpus.h"
+
+#endif  // CS_2D_DATA_CS2D_DATA_H_
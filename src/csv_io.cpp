@@ -0,0 +1,319 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// csv_io.cpp - 2DPackLib 兼容 CSV 快速序列化与解析实现
+
+#include "csv_io.h"
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+void CsvSerializer::AppendInt(long long value) {
+    char buf[24];
+    auto res = std::to_chars(buf, buf + sizeof(buf), value);
+    buffer_.append(buf, res.ptr);
+}
+
+const std::string& CsvSerializer::Format(const Instance& inst) {
+    buffer_.clear();
+    // 每行最多4个整数, 预留足够空间避免多次扩容
+    buffer_.reserve(160 + inst.items.size() * 48);
+
+    // 文件头
+    buffer_ += "# 2D Cutting Stock Problem Instance\n";
+    buffer_ += "# Generated by CS-2D-Data\n";
+    if (inst.known_optimal > 0) {
+        buffer_ += "# Known Optimal: ";
+        AppendInt(inst.known_optimal);
+        buffer_ += '\n';
+    }
+    buffer_ += "#\n";
+
+    // 母板尺寸
+    buffer_ += "stock_width,stock_length\n";
+    AppendInt(inst.stock_width);
+    buffer_ += ',';
+    AppendInt(inst.stock_length);
+    buffer_ += "\n#\n";
+
+    // 子板数据
+    buffer_ += "id,width,length,demand\n";
+    for (const auto& item : inst.items) {
+        AppendInt(item.id);
+        buffer_ += ',';
+        AppendInt(item.width);
+        buffer_ += ',';
+        AppendInt(item.length);
+        buffer_ += ',';
+        AppendInt(item.demand);
+        buffer_ += '\n';
+    }
+    return buffer_;
+}
+
+const std::string& CsvSerializer::FormatCertificate(const PackingCertificate& cert) {
+    buffer_.clear();
+    buffer_.reserve(160 + cert.NumStrips() * 16 + cert.piece_ids.size() * 4);
+
+    buffer_ += "# 2D Cutting Stock Packing Certificate\n";
+    buffer_ += "# Generated by CS-2D-Data\n";
+    buffer_ += "# Stocks: ";
+    AppendInt(cert.NumStocks());
+    buffer_ += "\n#\n";
+
+    buffer_ += "stock,strip_width,items\n";
+    for (int s = 0; s < cert.NumStocks(); s++) {
+        for (int k = cert.stock_begin[s]; k < cert.stock_begin[s + 1]; k++) {
+            AppendInt(s);
+            buffer_ += ',';
+            AppendInt(cert.strip_width[k]);
+            buffer_ += ',';
+            for (int p = cert.strip_begin[k]; p < cert.strip_begin[k + 1]; p++) {
+                if (p > cert.strip_begin[k]) buffer_ += ' ';
+                AppendInt(cert.piece_ids[p]);
+            }
+            buffer_ += '\n';
+        }
+    }
+    return buffer_;
+}
+
+bool CsvSerializer::Write(const Instance& inst, const std::string& filepath) {
+    Format(inst);
+    return WriteBuffer(filepath, buffer_.data(), buffer_.size());
+}
+
+std::FILE* CsvSerializer::WriteOpen(const Instance& inst, const std::string& filepath) {
+    Format(inst);
+    return WriteBufferOpen(filepath, buffer_.data(), buffer_.size());
+}
+
+bool CsvSerializer::WriteBuffer(const std::string& filepath, const char* data,
+                                size_t size) {
+    std::FILE* file = WriteBufferOpen(filepath, data, size);
+    return file && std::fclose(file) == 0;
+}
+
+std::FILE* CsvSerializer::WriteBufferOpen(const std::string& filepath,
+                                          const char* data, size_t size) {
+    // 文本模式, 与原 std::ofstream 输出逐字节一致 (含平台换行约定)
+    std::FILE* file = std::fopen(filepath.c_str(), "w");
+    if (!file) {
+        std::cerr << "Error: Cannot open file " << filepath << std::endl;
+        return nullptr;
+    }
+    // 关闭 stdio 缓冲, 整个缓冲区由一次 write 写出
+    std::setvbuf(file, nullptr, _IONBF, 0);
+    if (std::fwrite(data, 1, size, file) != size) {
+        std::cerr << "Error: Failed to write file " << filepath << std::endl;
+        std::fclose(file);
+        return nullptr;
+    }
+    return file;
+}
+
+bool CsvSerializer::SyncAndClose(std::FILE* file) {
+#ifdef _WIN32
+    bool ok = _commit(_fileno(file)) == 0;
+#else
+    bool ok = fsync(fileno(file)) == 0;
+#endif
+    return (std::fclose(file) == 0) && ok;
+}
+
+// ---------------------------------------------------------------------------
+// 解析
+// ---------------------------------------------------------------------------
+
+namespace {
+
+bool IsBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+// 解析一行中以逗号分隔的整数, 返回解析到的个数; 遇到非法字段返回 -1
+int ParseIntFields(const char* p, const char* end, long long* fields, int max_fields) {
+    int n = 0;
+    for (;;) {
+        while (p < end && IsBlank(*p)) p++;
+        if (n == max_fields) return -1;
+        auto res = std::from_chars(p, end, fields[n]);
+        if (res.ec != std::errc()) return -1;
+        n++;
+        p = res.ptr;
+        while (p < end && IsBlank(*p)) p++;
+        if (p == end) return n;
+        if (*p != ',') return -1;
+        p++;
+    }
+}
+
+}  // namespace
+
+bool CsvReader::Parse(const char* data, size_t size, Instance& out, std::string& error) {
+    static constexpr char kKnownOptimal[] = "# Known Optimal:";
+    static constexpr size_t kKnownOptimalLen = sizeof(kKnownOptimal) - 1;
+
+    out.stock_width = 0;
+    out.stock_length = 0;
+    out.known_optimal = -1;
+    out.difficulty = 0.0;
+    out.items.clear();
+    out.InvalidateStats();
+
+    bool has_stock = false;
+    int line_no = 0;
+    const char* p = data;
+    const char* end = data + size;
+    while (p < end) {
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        const char* line_end = eol ? eol : end;
+        line_no++;
+
+        const char* q = p;
+        while (q < line_end && IsBlank(*q)) q++;
+        if (q == line_end) {
+            // 空行
+        } else if (*q == '#') {
+            if (static_cast<size_t>(line_end - q) > kKnownOptimalLen &&
+                std::memcmp(q, kKnownOptimal, kKnownOptimalLen) == 0) {
+                long long value;
+                if (ParseIntFields(q + kKnownOptimalLen, line_end, &value, 1) != 1) {
+                    error = "line " + std::to_string(line_no) + ": bad known optimal";
+                    return false;
+                }
+                out.known_optimal = static_cast<int>(value);
+            }
+        } else if ((*q >= 'a' && *q <= 'z') || (*q >= 'A' && *q <= 'Z')) {
+            // 表头行
+        } else {
+            long long fields[4];
+            int n = ParseIntFields(q, line_end, fields, 4);
+            if (!has_stock && n == 2) {
+                out.stock_width = static_cast<int>(fields[0]);
+                out.stock_length = static_cast<int>(fields[1]);
+                has_stock = true;
+            } else if (has_stock && n == 4) {
+                out.items.push_back(Item{static_cast<int>(fields[0]), static_cast<int>(fields[1]),
+                                         static_cast<int>(fields[2]), static_cast<int>(fields[3])});
+            } else {
+                error = "line " + std::to_string(line_no) +
+                        (has_stock ? ": expected id,width,length,demand"
+                                   : ": expected stock_width,stock_length");
+                return false;
+            }
+        }
+        p = eol ? eol + 1 : end;
+    }
+
+    if (!has_stock) {
+        error = "missing stock dimensions";
+        return false;
+    }
+    if (out.items.empty()) {
+        error = "no items";
+        return false;
+    }
+    out.RefreshStats();     // 预先填好统计缓存, 解析结果可直接多线程共享
+    return true;
+}
+
+bool CsvReader::ParseCertificate(const char* data, size_t size, PackingCertificate& out,
+                                 std::string& error) {
+    out.Clear();
+    int line_no = 0;
+    const char* p = data;
+    const char* end = data + size;
+    while (p < end) {
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        const char* line_end = eol ? eol : end;
+        line_no++;
+
+        const char* q = p;
+        while (q < line_end && IsBlank(*q)) q++;
+        if (q != line_end && *q != '#' &&
+            !((*q >= 'a' && *q <= 'z') || (*q >= 'A' && *q <= 'Z'))) {
+            // stock,strip_width,id id ...
+            long long head[2];
+            const char* ids = q;
+            for (int f = 0; f < 2; f++) {
+                const char* comma = static_cast<const char*>(std::memchr(ids, ',', line_end - ids));
+                if (!comma || ParseIntFields(ids, comma, &head[f], 1) != 1) {
+                    error = "line " + std::to_string(line_no) + ": expected stock,strip_width,items";
+                    return false;
+                }
+                ids = comma + 1;
+            }
+            // 母板序号须从 0 起连续, 同一母板的条带相邻
+            const long long stock = head[0];
+            if (stock == out.NumStocks()) {
+                out.CloseStock();
+            } else if (stock != out.NumStocks() - 1) {
+                error = "line " + std::to_string(line_no) + ": stocks out of order";
+                return false;
+            }
+            out.strip_width.push_back(static_cast<int>(head[1]));
+            out.strip_begin.push_back(out.strip_begin.back());
+            out.stock_begin.back()++;
+            for (;;) {
+                while (ids < line_end && IsBlank(*ids)) ids++;
+                if (ids == line_end) break;
+                long long id;
+                auto res = std::from_chars(ids, line_end, id);
+                if (res.ec != std::errc()) {
+                    error = "line " + std::to_string(line_no) + ": bad item id";
+                    return false;
+                }
+                out.AddPiece(static_cast<int>(id));
+                ids = res.ptr;
+            }
+        }
+        p = eol ? eol + 1 : end;
+    }
+
+    if (out.Empty()) {
+        error = "no strips";
+        return false;
+    }
+    return true;
+}
+
+bool CsvReader::ReadCertificate(const std::string& filepath, PackingCertificate& out) {
+    return ReadFile(filepath) && ParseCertificate(buffer_.data(), buffer_.size(), out, error_);
+}
+
+bool CsvReader::Read(const std::string& filepath, Instance& out) {
+    return ReadFile(filepath) && Parse(buffer_.data(), buffer_.size(), out, error_);
+}
+
+bool CsvReader::ReadFile(const std::string& filepath) {
+    std::FILE* file = std::fopen(filepath.c_str(), "rb");
+    if (!file) {
+        error_ = "cannot open file";
+        return false;
+    }
+    bool ok = std::fseek(file, 0, SEEK_END) == 0;
+    long size = ok ? std::ftell(file) : -1;
+    ok = size >= 0 && std::fseek(file, 0, SEEK_SET) == 0;
+    if (ok) {
+        buffer_.resize(static_cast<size_t>(size));
+        ok = size == 0 ||
+             std::fread(&buffer_[0], 1, buffer_.size(), file) == buffer_.size();
+    }
+    std::fclose(file);
+    if (!ok) {
+        error_ = "cannot read file";
+        return false;
+    }
+    return true;
+}
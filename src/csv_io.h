@@ -0,0 +1,71 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// csv_io.h - 2DPackLib 兼容 CSV 快速序列化与解析
+// 写出: 整个文件以 std::to_chars 格式化到可复用缓冲区, 再一次性写出
+// 读取: 整个文件一次读入可复用缓冲区, 以 std::from_chars 原地解析, 不产生中间字符串
+
+#ifndef CS_2D_DATA_CSV_IO_H_
+#define CS_2D_DATA_CSV_IO_H_
+
+#include "instance.h"
+#include <cstdio>
+#include <string>
+
+class CsvSerializer {
+public:
+    // 格式化算例 (覆盖内部缓冲区, 保留容量), 返回缓冲区
+    const std::string& Format(const Instance& inst);
+
+    // 格式化并写出到文件 (不创建目录, 由调用方负责)
+    bool Write(const Instance& inst, const std::string& filepath);
+
+    // 格式化并写出, 文件保持打开以便调用方批量同步 (失败返回 nullptr)
+    std::FILE* WriteOpen(const Instance& inst, const std::string& filepath);
+
+    // 格式化装箱证书: 每行一条条带 "stock,strip_width,id id ...", 按母板顺序排列
+    const std::string& FormatCertificate(const PackingCertificate& cert);
+
+    // 以单次写操作写出任意缓冲区
+    static bool WriteBuffer(const std::string& filepath, const char* data, size_t size);
+    static std::FILE* WriteBufferOpen(const std::string& filepath,
+                                      const char* data, size_t size);
+
+    // 将文件数据同步到存储设备 (fsync) 并关闭
+    static bool SyncAndClose(std::FILE* file);
+
+private:
+    std::string buffer_;
+
+    void AppendInt(long long value);
+};
+
+class CsvReader {
+public:
+    // 读取并解析文件 (复用内部缓冲区); 失败时 Error() 给出原因
+    bool Read(const std::string& filepath, Instance& out);
+
+    // 解析内存中的 CSV 文本
+    // 识别 "# Known Optimal: N" 注释, 跳过其余注释与表头行, 兼容 CRLF
+    static bool Parse(const char* data, size_t size, Instance& out, std::string& error);
+
+    // 读取并解析装箱证书 (FormatCertificate 的格式)
+    bool ReadCertificate(const std::string& filepath, PackingCertificate& out);
+    static bool ParseCertificate(const char* data, size_t size, PackingCertificate& out,
+                                 std::string& error);
+
+    const std::string& Error() const { return error_; }
+
+private:
+    std::string buffer_;
+    std::string error_;
+
+    bool ReadFile(const std::string& filepath);
+};
+
+#endif  // CS_2D_DATA_CSV_IO_H_
@@ -9,28 +9,62 @@
 // difficulty_estimator.cpp - 求解难度预估与校准实现
 
 #include "difficulty_estimator.h"
+#include "strip_patterns.h"
 #include <fstream>
 #include <sstream>
 #include <cmath>
 #include <algorithm>
+#include <limits>
+#include <thread>
 
 DifficultyEstimator::DifficultyEstimator()
     : w_size_ratio_(0.35),    // 尺寸比是最关键因素
       w_num_types_(0.25),     // 种类数影响组合复杂度
       w_demand_(0.20),        // 低需求增加整数化难度
       w_cv_(0.15),            // 异质性影响装填效率
-      w_width_div_(0.05) {    // 宽度多样性影响条带类型数
+      w_width_div_(0.05),     // 宽度多样性影响条带类型数
+      w_patterns_(0.0) {      // 条带模式数 (默认不计入, 由校准确定)
+}
+
+namespace {
+
+// 模式因子; stats.strip_patterns < 0 表示未统计, 不计入
+inline double PatternFactor(double strip_patterns) {
+    return strip_patterns >= 0.0
+        ? std::log2(1.0 + strip_patterns) / DifficultyEstimator::kPatternScale
+        : 0.0;
+}
+
+}  // namespace
+
+double DifficultyEstimator::CountStripPatterns(const Instance& inst) {
+    // 每线程复用位集与排序缓冲区
+    thread_local StripPatternCounter counter;
+    return counter.Count(inst);
 }
 
 DifficultyEstimate DifficultyEstimator::Estimate(const Instance& inst) const {
+    InstanceStats stats = inst.Stats();
+    stats.strip_patterns = CountStripPatterns(inst);
+    return Estimate(stats);
+}
+
+double DifficultyEstimator::Score(const Instance& inst) const {
+    InstanceStats stats = inst.Stats();
+    // 模式权重为零时不影响评分, 省去计数
+    if (w_patterns_ != 0.0) stats.strip_patterns = CountStripPatterns(inst);
+    return Score(stats);
+}
+
+DifficultyEstimate DifficultyEstimator::Estimate(const InstanceStats& stats) const {
     DifficultyEstimate result;
 
     // 提取算例特征
-    double size_ratio = inst.AvgSizeRatio();
-    int num_types = inst.NumTypes();
-    double avg_demand = inst.AvgDemand();
-    double size_cv = inst.SizeCV();
-    double width_div = inst.WidthDiversity();
+    double size_ratio = stats.AvgSizeRatio();
+    int num_types = stats.num_types;
+    double avg_demand = stats.AvgDemand();
+    double size_cv = stats.SizeCV();
+    double width_div = stats.WidthDiversity();
 
     // 计算各因素的归一化贡献
     // 尺寸比: 以20%为基准, 越大越难
@@ -48,12 +82,17 @@ DifficultyEstimate DifficultyEstimator::Estimate(const Instance& inst) const {
     // 宽度多样性: 直接使用
     result.width_div_contribution = width_div;
 
+    // 条带模式数: 对数尺度, 以 2^10 为基准
+    result.strip_patterns = std::max(stats.strip_patterns, 0.0);
+    result.patterns_contribution = PatternFactor(stats.strip_patterns);
+
     // 加权求和得到综合评分
     result.score = w_size_ratio_ * result.size_contribution
                  + w_num_types_ * result.types_contribution
                  + w_demand_ * result.demand_contribution
                  + w_cv_ * result.cv_contribution
-                 + w_width_div_ * result.width_div_contribution;
+                 + w_width_div_ * result.width_div_contribution
+                 + w_patterns_ * result.patterns_contribution;
 
     // 映射到难度等级
     result.level = ScoreToLevel(result.score);
@@ -64,11 +103,11 @@ DifficultyEstimate DifficultyEstimator::Estimate(const Instance& inst) const {
     result.estimated_nodes = EstimateNodes(result.score);
 
     // 利用率下界 = 总需求面积 / (理论最少板数 * 板面积)
-    double lb = inst.TheoreticalLowerBound();
+    double lb = stats.TheoreticalLowerBound();
     int lb_plates = static_cast<int>(std::ceil(lb));
-    if (lb_plates > 0 && inst.StockArea() > 0) {
-        result.utilization_lb = static_cast<double>(inst.TotalDemandArea())
-                              / (lb_plates * inst.StockArea());
+    if (lb_plates > 0 && stats.StockArea() > 0) {
+        result.utilization_lb = static_cast<double>(stats.total_demand_area)
+                              / (lb_plates * stats.StockArea());
     } else {
         result.utilization_lb = 0.0;
     }
@@ -76,68 +115,347 @@ DifficultyEstimate DifficultyEstimator::Estimate(const Instance& inst) const {
     return result;
 }
 
+double DifficultyEstimator::Score(const InstanceStats& stats) const {
+    return ComputeScore(stats.AvgSizeRatio(), stats.num_types, stats.AvgDemand(),
+                        stats.SizeCV(), stats.WidthDiversity(), stats.strip_patterns);
+}
+
+void DifficultyEstimator::ComputeFactors(double size_ratio, int num_types,
+                                         double avg_demand, double size_cv,
+                                         double width_diversity, double strip_patterns,
+                                         double factors[kNumFactors]) {
+    factors[0] = size_ratio / 0.20;
+    factors[1] = static_cast<double>(num_types) / 30.0;
+    factors[2] = (avg_demand > 0) ? 5.0 / avg_demand : 2.0;
+    factors[3] = size_cv / 0.30;
+    factors[4] = width_diversity;
+    factors[5] = PatternFactor(strip_patterns);
+}
+
 double DifficultyEstimator::ComputeScore(double size_ratio, int num_types,
                                           double avg_demand, double size_cv,
-                                          double width_diversity) const {
-    double f_size = size_ratio / 0.20;
-    double f_types = static_cast<double>(num_types) / 30.0;
-    double f_demand = (avg_demand > 0) ? 5.0 / avg_demand : 2.0;
-    double f_cv = size_cv / 0.30;
-    double f_width = width_diversity;
-
-    return w_size_ratio_ * f_size
-         + w_num_types_ * f_types
-         + w_demand_ * f_demand
-         + w_cv_ * f_cv
-         + w_width_div_ * f_width;
+                                          double width_diversity, double strip_patterns) const {
+    double f[kNumFactors];
+    ComputeFactors(size_ratio, num_types, avg_demand, size_cv, width_diversity,
+                   strip_patterns, f);
+
+    return w_size_ratio_ * f[0]
+         + w_num_types_ * f[1]
+         + w_demand_ * f[2]
+         + w_cv_ * f[3]
+         + w_width_div_ * f[4]
+         + w_patterns_ * f[5];
+}
+
+namespace {
+
+constexpr int kNumLevels = static_cast<int>(DifficultyLevel::kExpert) + 1;
+
+// 等级下限阈值; 等级 = 评分不低于的阈值个数
+constexpr double kLevelThresholds[kNumLevels - 1] = {0.5, 0.8, 1.2, 1.6, 2.0};
+
+constexpr const char* kLevelNames[kNumLevels] = {
+    "极易", "简单", "中等", "困难", "很难", "极难"
+};
+
+// Gap范围与分支节点数按等级查表 (分段点与等级阈值相同)
+constexpr const char* kGapStrings[kNumLevels] = {
+    "<1%", "1-3%", "3-8%", "8-15%", "15-25%", ">25%"
+};
+
+constexpr int kLevelNodes[kNumLevels] = {10, 50, 300, 1000, 5000, 10000};
+
+// 批量评分的块大小: 6列特征共 12 KB, 可留在 L1 中
+constexpr size_t kBatchBlock = 256;
+
+inline int LevelIndex(double score) {
+    int level = 0;
+    for (double threshold : kLevelThresholds) {
+        level += score >= threshold;
+    }
+    return level;
+}
+
+}  // namespace
+
+DifficultyLevel DifficultyEstimator::LevelOf(double score) {
+    return static_cast<DifficultyLevel>(LevelIndex(score));
+}
+
+const char* DifficultyEstimator::LevelName(DifficultyLevel level) {
+    int index = static_cast<int>(level);
+    return (index >= 0 && index < kNumLevels) ? kLevelNames[index] : "未知";
+}
+
+const char* DifficultyEstimator::GapString(DifficultyLevel level) {
+    int index = static_cast<int>(level);
+    return (index >= 0 && index < kNumLevels) ? kGapStrings[index] : "";
+}
+
+int DifficultyEstimator::NodesForLevel(DifficultyLevel level) {
+    int index = static_cast<int>(level);
+    return (index >= 0 && index < kNumLevels) ? kLevelNodes[index] : 0;
 }
 
 DifficultyLevel DifficultyEstimator::ScoreToLevel(double score) const {
-    if (score < 0.5) return DifficultyLevel::kTrivial;
-    if (score < 0.8) return DifficultyLevel::kEasy;
-    if (score < 1.2) return DifficultyLevel::kMedium;
-    if (score < 1.6) return DifficultyLevel::kHard;
-    if (score < 2.0) return DifficultyLevel::kVeryHard;
-    return DifficultyLevel::kExpert;
+    return LevelOf(score);
 }
 
-std::string DifficultyEstimator::LevelToString(DifficultyLevel level) const {
-    switch (level) {
-        case DifficultyLevel::kTrivial:  return "极易";
-        case DifficultyLevel::kEasy:     return "简单";
-        case DifficultyLevel::kMedium:   return "中等";
-        case DifficultyLevel::kHard:     return "困难";
-        case DifficultyLevel::kVeryHard: return "很难";
-        case DifficultyLevel::kExpert:   return "极难";
-        default: return "未知";
-    }
+const char* DifficultyEstimator::LevelToString(DifficultyLevel level) const {
+    return LevelName(level);
 }
 
-std::string DifficultyEstimator::EstimateGapString(double score) const {
+const char* DifficultyEstimator::EstimateGapString(double score) const {
     // 根据难度评分预估Gap范围
-    if (score < 0.5) return "<1%";
-    if (score < 0.8) return "1-3%";
-    if (score < 1.2) return "3-8%";
-    if (score < 1.6) return "8-15%";
-    if (score < 2.0) return "15-25%";
-    return ">25%";
+    return kGapStrings[LevelIndex(score)];
 }
 
 int DifficultyEstimator::EstimateNodes(double score) const {
     // 根据难度评分预估分支节点数
-    if (score < 0.5) return 10;
-    if (score < 0.8) return 50;
-    if (score < 1.2) return 300;
-    if (score < 1.6) return 1000;
-    if (score < 2.0) return 5000;
-    return 10000;
+    return kLevelNodes[LevelIndex(score)];
+}
+
+void DifficultyEstimator::EstimateBatch(const InstanceStats* stats, size_t n, double* scores,
+                                        DifficultyLevel* levels, int* nodes) const {
+    alignas(64) double f_size[kBatchBlock];
+    alignas(64) double f_types[kBatchBlock];
+    alignas(64) double avg_demand[kBatchBlock];
+    alignas(64) double f_cv[kBatchBlock];
+    alignas(64) double f_width[kBatchBlock];
+    alignas(64) double f_patterns[kBatchBlock];
+    alignas(64) int level_index[kBatchBlock];
+
+    for (size_t begin = 0; begin < n; begin += kBatchBlock) {
+        const size_t m = std::min(kBatchBlock, n - begin);
+        const InstanceStats* block = stats + begin;
+        double* out = scores + begin;
+
+        // AoS -> SoA: 提取原始特征 (含开方等标量运算)
+        for (size_t i = 0; i < m; i++) {
+            f_size[i] = block[i].AvgSizeRatio();
+            f_types[i] = static_cast<double>(block[i].num_types);
+            avg_demand[i] = block[i].AvgDemand();
+            f_cv[i] = block[i].SizeCV();
+            f_width[i] = block[i].WidthDiversity();
+            f_patterns[i] = PatternFactor(block[i].strip_patterns);
+        }
+
+        // 归一化与加权求和, 运算顺序与 ComputeScore 相同
+        for (size_t i = 0; i < m; i++) {
+            double fs = f_size[i] / 0.20;
+            double ft = f_types[i] / 30.0;
+            double fd = (avg_demand[i] > 0) ? 5.0 / avg_demand[i] : 2.0;
+            double fc = f_cv[i] / 0.30;
+            out[i] = w_size_ratio_ * fs
+                   + w_num_types_ * ft
+                   + w_demand_ * fd
+                   + w_cv_ * fc
+                   + w_width_div_ * f_width[i]
+                   + w_patterns_ * f_patterns[i];
+        }
+
+        if (!levels && !nodes) continue;
+
+        // 无分支等级分桶
+        for (size_t i = 0; i < m; i++) {
+            level_index[i] = (out[i] >= kLevelThresholds[0]) + (out[i] >= kLevelThresholds[1])
+                           + (out[i] >= kLevelThresholds[2]) + (out[i] >= kLevelThresholds[3])
+                           + (out[i] >= kLevelThresholds[4]);
+        }
+        if (levels) {
+            for (size_t i = 0; i < m; i++) {
+                levels[begin + i] = static_cast<DifficultyLevel>(level_index[i]);
+            }
+        }
+        if (nodes) {
+            for (size_t i = 0; i < m; i++) {
+                nodes[begin + i] = kLevelNodes[level_index[i]];
+            }
+        }
+    }
 }
 
 void DifficultyEstimator::AddCalibrationPoint(const CalibrationPoint& point) {
     calibration_data_.push_back(point);
 }
 
-double DifficultyEstimator::Calibrate() {
+namespace {
+
+constexpr int kK = DifficultyEstimator::kNumFactors;
+
+// 第i个权重的取值范围: 五项基础权重 [kMinWeight, kMaxWeight], 模式权重 [0, kMaxWeight]
+void WeightBounds(int i, double& lo, double& hi) {
+    lo = (i == kK - 1) ? 0.0 : DifficultyEstimator::kMinWeight;
+    hi = DifficultyEstimator::kMaxWeight;
+}
+
+// 校准用的最小二乘正规方程: SSE(w) = w'Gw - 2b'w + c
+// 因子矩阵只遍历一次, 此后任意权重的误差评估与数据点数无关
+struct NormalEquations {
+    double gram[kK][kK] = {};   // G = F'F
+    double rhs[kK] = {};        // b = F'y
+    double yy = 0.0;            // c = y'y
+    size_t num_points = 0;
+
+    double SSE(const double w[kK]) const {
+        double sse = yy;
+        for (int i = 0; i < kK; i++) {
+            double gw = 0.0;
+            for (int j = 0; j < kK; j++) gw += gram[i][j] * w[j];
+            sse += w[i] * gw - 2.0 * rhs[i] * w[i];
+        }
+        return std::max(sse, 0.0);
+    }
+
+    // 模式因子列全为零 (数据点未填条带模式数): 该列无信息, 模式权重固定为0
+    bool PatternColumnEmpty() const { return gram[kK - 1][kK - 1] == 0.0; }
+};
+
+// 求解 KKT 系统 [2G 1; 1' 0][w; λ] = [2b; 1] (部分主元高斯消元)
+// 模式因子列全为零时该行换成 w_patterns = 0, 即按五项基础因子求解
+bool SolveConstrainedLeastSquares(const NormalEquations& eq, double w[kK]) {
+    constexpr int kN = kK + 1;
+    double a[kN][kN + 1] = {};
+    for (int i = 0; i < kK; i++) {
+        for (int j = 0; j < kK; j++) a[i][j] = 2.0 * eq.gram[i][j];
+        a[i][kK] = 1.0;
+        a[i][kN] = 2.0 * eq.rhs[i];
+        a[kK][i] = 1.0;
+    }
+    a[kK][kN] = 1.0;
+    if (eq.PatternColumnEmpty()) {
+        for (int c = 0; c <= kN; c++) a[kK - 1][c] = 0.0;
+        a[kK - 1][kK - 1] = 1.0;
+    }
+
+    double scale = 0.0;
+    for (int i = 0; i < kK; i++) scale = std::max(scale, std::abs(a[i][i]));
+    const double eps = 1e-12 * std::max(scale, 1.0);
+
+    for (int col = 0; col < kN; col++) {
+        int pivot = col;
+        for (int r = col + 1; r < kN; r++) {
+            if (std::abs(a[r][col]) > std::abs(a[pivot][col])) pivot = r;
+        }
+        if (std::abs(a[pivot][col]) < eps) return false;   // 奇异 (特征共线或恒为零)
+        if (pivot != col) {
+            for (int c = 0; c <= kN; c++) std::swap(a[col][c], a[pivot][c]);
+        }
+        for (int r = 0; r < kN; r++) {
+            if (r == col) continue;
+            double factor = a[r][col] / a[col][col];
+            for (int c = col; c <= kN; c++) a[r][c] -= factor * a[col][c];
+        }
+    }
+    for (int i = 0; i < kK; i++) {
+        w[i] = a[i][kN] / a[i][i];
+        if (!std::isfinite(w[i])) return false;
+    }
+    return true;
+}
+
+// 网格搜索: 权重以 1/units 为单位, 前 kK-1 个枚举, 最后一个由和为1确定; 各维取 [lo[i], hi[i]] 单位
+// 按第一个权重的取值分给各线程, 并按 (SSE, 枚举序) 归约, 结果与线程数无关
+double GridSearch(const NormalEquations& eq, int units, const int lo[kK], const int hi[kK],
+                  int best_k[kK]) {
+    struct Best {
+        double sse = std::numeric_limits<double>::infinity();
+        int k[kK] = {};
+    };
+
+    const int span = hi[0] - lo[0] + 1;
+    int num_threads = static_cast<int>(std::thread::hardware_concurrency());
+    num_threads = std::clamp(num_threads, 1, std::max(span, 1));
+    std::vector<Best> best(num_threads);
+
+    auto worker = [&](int t) {
+        Best& local = best[t];
+        int k[kK];
+        double w[kK];
+        // 逐维递归枚举, 剩余单位数超出后续维度可行范围时剪枝
+        auto recurse = [&](auto& self, int dim, int remaining) -> void {
+            if (dim == kK - 1) {
+                if (remaining < lo[dim] || remaining > hi[dim]) return;
+                k[dim] = remaining;
+                w[dim] = remaining / static_cast<double>(units);
+                double sse = eq.SSE(w);
+                if (sse < local.sse) {
+                    local.sse = sse;
+                    std::copy(k, k + kK, local.k);
+                }
+                return;
+            }
+            int rest_lo = 0, rest_hi = 0;
+            for (int d = dim + 1; d < kK; d++) {
+                rest_lo += lo[d];
+                rest_hi += hi[d];
+            }
+            for (int v = lo[dim]; v <= hi[dim]; v++) {
+                if (remaining - v < rest_lo) break;
+                if (remaining - v > rest_hi) continue;
+                k[dim] = v;
+                w[dim] = v / static_cast<double>(units);
+                self(self, dim + 1, remaining - v);
+            }
+        };
+        for (int k0 = lo[0] + t; k0 <= hi[0]; k0 += num_threads) {
+            k[0] = k0;
+            w[0] = k0 / static_cast<double>(units);
+            recurse(recurse, 1, units - k0);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (int t = 0; t < num_threads; t++) threads.emplace_back(worker, t);
+    for (auto& th : threads) th.join();
+
+    // 归约: SSE 相同时取枚举序最小者
+    const Best* result = &best[0];
+    for (const Best& b : best) {
+        if (b.sse < result->sse ||
+            (b.sse == result->sse && std::lexicographical_compare(b.k, b.k + kK,
+                                                                   result->k, result->k + kK))) {
+            result = &b;
+        }
+    }
+    std::copy(result->k, result->k + kK, best_k);
+    return result->sse;
+}
+
+// 两级网格搜索: 先以 0.05 步长搜索整个可行域, 再在最优点 ±0.05 内以 0.01 步长细化
+// (目标函数为凸二次函数, 细化邻域覆盖粗网格的一个步长); 模式因子列全为零时模式权重固定为0
+void CoarseToFineSearch(const NormalEquations& eq, double w[kK]) {
+    int lo[kK], hi[kK], k[kK];
+    constexpr int kCoarse = 20;
+    constexpr int kFine = 100;
+    const bool no_patterns = eq.PatternColumnEmpty();
+    auto bounds = [no_patterns](int i, double& lo_w, double& hi_w) {
+        WeightBounds(i, lo_w, hi_w);
+        if (no_patterns && i == kK - 1) hi_w = 0.0;
+    };
+    for (int i = 0; i < kK; i++) {
+        double lo_w, hi_w;
+        bounds(i, lo_w, hi_w);
+        lo[i] = static_cast<int>(std::lround(lo_w * kCoarse));
+        hi[i] = static_cast<int>(std::lround(hi_w * kCoarse));
+    }
+    GridSearch(eq, kCoarse, lo, hi, k);
+
+    constexpr int kRatio = kFine / kCoarse;
+    for (int i = 0; i < kK; i++) {
+        double lo_w, hi_w;
+        bounds(i, lo_w, hi_w);
+        lo[i] = std::max(static_cast<int>(std::lround(lo_w * kFine)), (k[i] - 1) * kRatio);
+        hi[i] = std::min(static_cast<int>(std::lround(hi_w * kFine)), (k[i] + 1) * kRatio);
+    }
+    GridSearch(eq, kFine, lo, hi, k);
+    for (int i = 0; i < kK; i++) w[i] = k[i] / static_cast<double>(kFine);
+}
+
+}  // namespace
+
+double DifficultyEstimator::Calibrate(CalibrationMethod method) {
     if (calibration_data_.size() < 5) {
         return 0.0;  // 数据点太少无法校准
     }
@@ -145,50 +463,55 @@ double DifficultyEstimator::Calibrate() {
     // 计算校准前的RMSE
     double rmse_before = GetPredictionRMSE();
 
-    // 简单的网格搜索优化权重
-    // 约束: 所有权重之和为1, 每个权重在0.05-0.50之间
-    double best_rmse = rmse_before;
-    double best_w[5] = {w_size_ratio_, w_num_types_, w_demand_, w_cv_, w_width_div_};
-
-    // 保存原始权重
-    double orig_w[5] = {w_size_ratio_, w_num_types_, w_demand_, w_cv_, w_width_div_};
-
-    // 网格搜索 (步长0.05)
-    for (double w1 = 0.20; w1 <= 0.50; w1 += 0.05) {      // size_ratio
-        for (double w2 = 0.15; w2 <= 0.40; w2 += 0.05) {  // num_types
-            for (double w3 = 0.10; w3 <= 0.30; w3 += 0.05) {  // demand
-                double w4 = 1.0 - w1 - w2 - w3 - 0.05;  // cv (留0.05给width_div)
-                if (w4 < 0.05 || w4 > 0.30) continue;
-                double w5 = 1.0 - w1 - w2 - w3 - w4;    // width_div
-
-                // 临时设置权重
-                w_size_ratio_ = w1;
-                w_num_types_ = w2;
-                w_demand_ = w3;
-                w_cv_ = w4;
-                w_width_div_ = w5;
-
-                double rmse = GetPredictionRMSE();
-                if (rmse < best_rmse) {
-                    best_rmse = rmse;
-                    best_w[0] = w1;
-                    best_w[1] = w2;
-                    best_w[2] = w3;
-                    best_w[3] = w4;
-                    best_w[4] = w5;
-                }
-            }
+    // 一次遍历因子矩阵, 累积正规方程
+    NormalEquations eq;
+    eq.num_points = calibration_data_.size();
+    for (const auto& point : calibration_data_) {
+        double f[kNumFactors];
+        ComputeFactors(point.avg_size_ratio, point.num_types, point.avg_demand,
+                       point.size_cv, point.width_diversity, point.strip_patterns, f);
+        // 将实际gap映射到score (简化: gap*10 约等于 score)
+        double y = point.actual_gap * 10.0;
+        for (int i = 0; i < kNumFactors; i++) {
+            for (int j = i; j < kNumFactors; j++) eq.gram[i][j] += f[i] * f[j];
+            eq.rhs[i] += f[i] * y;
         }
+        eq.yy += y * y;
+    }
+    for (int i = 0; i < kNumFactors; i++) {
+        for (int j = 0; j < i; j++) eq.gram[i][j] = eq.gram[j][i];
     }
 
-    // 应用最优权重
-    w_size_ratio_ = best_w[0];
-    w_num_types_ = best_w[1];
-    w_demand_ = best_w[2];
-    w_cv_ = best_w[3];
-    w_width_div_ = best_w[4];
+    // 约束: 所有权重之和为1, 每个权重在各自范围内
+    // 闭式解落在范围内即为约束问题的最优解, 否则退回网格搜索
+    double w[kNumFactors];
+    bool solved = false;
+    if (method == CalibrationMethod::kClosedForm &&
+        SolveConstrainedLeastSquares(eq, w)) {
+        solved = true;
+        for (int i = 0; i < kNumFactors; i++) {
+            double lo, hi;
+            WeightBounds(i, lo, hi);
+            solved = solved && w[i] >= lo && w[i] <= hi;
+        }
+    }
+    if (!solved) {
+        CoarseToFineSearch(eq, w);
+    }
+
+    // 仅在误差改善时应用新权重
+    double old_w[kNumFactors] = {w_size_ratio_, w_num_types_, w_demand_, w_cv_,
+                                 w_width_div_, w_patterns_};
+    SetWeights(w[0], w[1], w[2], w[3], w[4]);
+    SetPatternWeight(w[5]);
+    double rmse_after = GetPredictionRMSE();
+    if (rmse_after >= rmse_before) {
+        SetWeights(old_w[0], old_w[1], old_w[2], old_w[3], old_w[4]);
+        SetPatternWeight(old_w[5]);
+        return 0.0;
+    }
 
-    return rmse_before - best_rmse;  // 返回RMSE改进量
+    return rmse_before - rmse_after;  // 返回RMSE改进量
 }
 
 double DifficultyEstimator::GetPredictionRMSE() const {
@@ -199,7 +522,8 @@ double DifficultyEstimator::GetPredictionRMSE() const {
         // 计算预测的difficulty score
         double predicted_score = ComputeScore(
             point.avg_size_ratio, point.num_types,
-            point.avg_demand, point.size_cv, point.width_diversity);
+            point.avg_demand, point.size_cv, point.width_diversity,
+            point.strip_patterns);
 
         // 将实际gap映射到score (简化: gap*10 约等于 score)
         double actual_score = point.actual_gap * 10.0;
@@ -246,6 +570,7 @@ bool DifficultyEstimator::SaveCalibration(const std::string& filepath) const {
     file << "w_demand=" << w_demand_ << "\n";
     file << "w_cv=" << w_cv_ << "\n";
     file << "w_width_div=" << w_width_div_ << "\n";
+    file << "w_patterns=" << w_patterns_ << "\n";
 
     return true;
 }
@@ -269,6 +594,7 @@ bool DifficultyEstimator::LoadCalibration(const std::string& filepath) {
         else if (key == "w_demand") w_demand_ = value;
         else if (key == "w_cv") w_cv_ = value;
         else if (key == "w_width_div") w_width_div_ = value;
+        else if (key == "w_patterns") w_patterns_ = value;
     }
 
     return true;
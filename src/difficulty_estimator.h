@@ -30,10 +30,10 @@ enum class DifficultyLevel {
 struct DifficultyEstimate {
     double score;                // 综合难度评分 (0.0 - 2.0+)
     DifficultyLevel level;       // 难度等级
-    std::string level_name;      // 等级名称 (中文)
-    std::string estimated_gap;   // 预估Gap范围 (如 "5-10%")
+    const char* level_name;      // 等级名称 (中文, 静态字符串表)
+    const char* estimated_gap;   // 预估Gap范围 (如 "5-10%", 静态字符串表)
     int estimated_nodes;         // 预估分支节点数
-    double utilization_lb;       // 利用率下界
+    double utilization_lb;       // 利用率下界 (面积下界; 组合下界版见 BoundReport::utilization_lb)
 
     // 各因素贡献值 (用于分析)
     double size_contribution;
@@ -41,6 +41,9 @@ struct DifficultyEstimate {
     double demand_contribution;
     double cv_contribution;
     double width_div_contribution;
+    double patterns_contribution;
+
+    double strip_patterns;       // 条带填充模式数 (各宽度不同填充长度数之和)
 };
 
 // 校准数据点 (来自实际求解结果)
@@ -51,6 +54,7 @@ struct CalibrationPoint {
     double avg_demand;
     double size_cv;
     double width_diversity;
+    double strip_patterns = 0.0;    // 条带填充模式数
 
     // 求解结果
     double actual_gap;      // 实际Gap
@@ -59,19 +63,61 @@ struct CalibrationPoint {
     bool timed_out;         // 是否超时
 };
 
+// 权重校准方法
+enum class CalibrationMethod {
+    kClosedForm,    // 等式约束最小二乘 (KKT 闭式解), 越出权重范围时退回网格搜索
+    kGridSearch     // 并行网格搜索 (0.05 步长全域, 再以 0.01 步长细化)
+};
+
 // 难度预估器
 class DifficultyEstimator {
 public:
     DifficultyEstimator();
 
-    // 预估算例难度
+    // 预估算例难度 (使用算例缓存的统计量, 并统计条带填充模式数)
     DifficultyEstimate Estimate(const Instance& inst) const;
 
+    // 基于已计算的统计量预估难度
+    // 注意: Instance::Stats() 不统计条带模式 (strip_patterns = -1), 模式项此时不计入,
+    // 权重 w_patterns 非零时评分低于 Estimate(inst); 与生成时一致须先设置
+    // stats.strip_patterns = CountStripPatterns(inst)
+    DifficultyEstimate Estimate(const InstanceStats& stats) const;
+
+    // 仅计算综合评分 (不填充等级/字符串, 供增量调优等热路径使用)
+    // stats 版本同样要求调用方填好 strip_patterns (见上)
+    double Score(const InstanceStats& stats) const;
+    double Score(const Instance& inst) const;
+
+    // 算例的条带填充模式数 (位集DP, 微秒级)
+    static double CountStripPatterns(const Instance& inst);
+
+    // 批量评分: 对 stats[0..n) 写出 scores[0..n), levels/nodes 非空时一并写出
+    // 统计量按块转为 SoA 特征列, 加权求和与等级分桶为无分支定长循环 (可自动向量化);
+    // 评分与逐个调用 Score 逐位一致, 等级字符串由 LevelName/GapString 按需解析;
+    // 各统计量的 strip_patterns 须已填好 (见 Estimate)
+    void EstimateBatch(const InstanceStats* stats, size_t n, double* scores,
+                       DifficultyLevel* levels = nullptr, int* nodes = nullptr) const;
+
+    // 评分 -> 等级 (阈值 0.5/0.8/1.2/1.6/2.0)
+    static DifficultyLevel LevelOf(double score);
+
+    // 等级对应的名称 / 预估Gap / 预估节点数 (静态字符串表)
+    static const char* LevelName(DifficultyLevel level);
+    static const char* GapString(DifficultyLevel level);
+    static int NodesForLevel(DifficultyLevel level);
+
     // 添加校准数据点
     void AddCalibrationPoint(const CalibrationPoint& point);
 
-    // 执行校准优化权重, 返回RMSE改进量
-    double Calibrate();
+    // 执行校准优化权重 (权重之和为1, 五项基础权重在 kMinWeight-kMaxWeight 之间,
+    // 模式权重在 0-kMaxWeight 之间; 数据点的 strip_patterns 全为0时模式权重固定为0,
+    // 按五项因子求解), 返回RMSE改进量
+    double Calibrate(CalibrationMethod method = CalibrationMethod::kClosedForm);
+
+    static constexpr int kNumFactors = 6;
+    static constexpr double kMinWeight = 0.05;
+    static constexpr double kMaxWeight = 0.50;
+    static constexpr double kPatternScale = 10.0;   // 模式因子 = log2(1 + 模式数) / 10
 
     // 保存/加载校准参数
     bool SaveCalibration(const std::string& filepath) const;
@@ -83,6 +129,10 @@ public:
     void SetWeights(double w_size, double w_types, double w_demand,
                     double w_cv, double w_width_div);
 
+    // 条带模式权重 (默认0, 由校准确定)
+    double GetPatternWeight() const { return w_patterns_; }
+    void SetPatternWeight(double w_patterns) { w_patterns_ = w_patterns; }
+
     // 校准统计
     int GetCalibrationPointCount() const;
     double GetPredictionRMSE() const;
@@ -94,16 +144,20 @@ private:
     double w_demand_;       // 需求量权重 (默认0.20)
     double w_cv_;           // 变异系数权重 (默认0.15)
     double w_width_div_;    // 宽度多样性权重 (默认0.05)
+    double w_patterns_;     // 条带模式权重 (默认0.00)
 
     // 校准数据
     std::vector<CalibrationPoint> calibration_data_;
 
     // 内部方法
+    static void ComputeFactors(double size_ratio, int num_types, double avg_demand,
+                               double size_cv, double width_diversity, double strip_patterns,
+                               double factors[kNumFactors]);
     double ComputeScore(double size_ratio, int num_types, double avg_demand,
-                        double size_cv, double width_diversity) const;
+                        double size_cv, double width_diversity, double strip_patterns) const;
     DifficultyLevel ScoreToLevel(double score) const;
-    std::string LevelToString(DifficultyLevel level) const;
-    std::string EstimateGapString(double score) const;
+    const char* LevelToString(DifficultyLevel level) const;
+    const char* EstimateGapString(double score) const;
     int EstimateNodes(double score) const;
 };
 
@@ -0,0 +1,176 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// fingerprint.cpp - 算例指纹与指纹索引实现
+
+#include "fingerprint.h"
+#include "rng.h"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+constexpr uint64_t kMul1 = 0x9E3779B97F4A7C15ULL;
+constexpr uint64_t kMul2 = 0xC2B2AE3D27D4EB4FULL;
+
+inline uint64_t Rotl(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+// 逐 64 位字吸收 (乘-旋转-乘), 每个子板两个字
+inline uint64_t Absorb(uint64_t h, uint64_t word) {
+    h ^= Rotl(word * kMul2, 31) * kMul1;
+    return Rotl(h, 27) * 5 + 0x52DCE729;
+}
+
+inline uint64_t PackPair(int a, int b) {
+    return static_cast<uint64_t>(static_cast<uint32_t>(a)) |
+           (static_cast<uint64_t>(static_cast<uint32_t>(b)) << 32);
+}
+
+}  // namespace
+
+uint64_t ComputeFingerprint(const Instance& inst) {
+    // 子板按 (宽度, 长度, 需求) 排序后依次吸收, 与原顺序和编号无关
+    thread_local std::vector<std::array<int, 3>> sorted;
+    sorted.clear();
+    sorted.reserve(inst.items.size());
+    for (const Item& item : inst.items) {
+        sorted.push_back({item.width, item.length, item.demand});
+    }
+    std::sort(sorted.begin(), sorted.end());
+
+    uint64_t h = Absorb(0, PackPair(inst.stock_width, inst.stock_length));
+    for (const auto& item : sorted) {
+        h = Absorb(h, PackPair(item[0], item[1]));
+        h = Absorb(h, static_cast<uint64_t>(static_cast<uint32_t>(item[2])));
+    }
+    h = SplitMix64(h ^ sorted.size());
+    return h != 0 ? h : 1;     // 0 留作空槽标记
+}
+
+bool FingerprintIndex::Open(const std::string& path, uint64_t max_new) {
+    path_ = path;
+    max_new_ = max_new;
+    num_added_.store(0);
+
+    std::vector<uint64_t> loaded;
+    std::error_code ec;
+    if (std::filesystem::exists(path, ec)) {
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        if (!file) {
+            std::cerr << "Error: Cannot open file " << path << std::endl;
+            return false;
+        }
+        FingerprintFileHeader header{};
+        bool ok = std::fread(&header, sizeof(header), 1, file) == 1 &&
+                  std::memcmp(header.magic, kFingerprintMagic, sizeof(kFingerprintMagic)) == 0 &&
+                  header.version == kFingerprintVersion;
+        if (ok) {
+            loaded.resize(header.count);
+            ok = header.count == 0 ||
+                 std::fread(loaded.data(), sizeof(uint64_t), header.count, file) == header.count;
+        }
+        std::fclose(file);
+        if (!ok) {
+            std::cerr << "Error: Invalid fingerprint index " << path << std::endl;
+            return false;
+        }
+    }
+
+    // 装载率不超过 1/2; 额外余量容纳并发插入越过 max_new 检查的少数指纹
+    uint64_t capacity = 64;
+    while (capacity < 2 * (loaded.size() + max_new) + 64) capacity <<= 1;
+    slots_.reset(new std::atomic<uint64_t>[capacity]);
+    for (uint64_t i = 0; i < capacity; i++) slots_[i].store(0, std::memory_order_relaxed);
+    mask_ = capacity - 1;
+    added_.reset(new uint64_t[std::max<uint64_t>(max_new, 1)]);
+
+    num_loaded_ = 0;
+    for (uint64_t fp : loaded) {
+        if (Place(fp)) num_loaded_++;
+    }
+    return true;
+}
+
+bool FingerprintIndex::Place(uint64_t fingerprint) {
+    for (uint64_t pos = SplitMix64(fingerprint) & mask_;; pos = (pos + 1) & mask_) {
+        uint64_t current = slots_[pos].load(std::memory_order_acquire);
+        if (current == fingerprint) return false;
+        if (current == 0) {
+            if (slots_[pos].compare_exchange_strong(current, fingerprint,
+                                                    std::memory_order_acq_rel)) {
+                return true;
+            }
+            if (current == fingerprint) return false;   // 其他线程刚插入同一指纹
+        }
+    }
+}
+
+bool FingerprintIndex::Insert(uint64_t fingerprint) {
+    if (Contains(fingerprint)) return false;
+    if (num_added_.load(std::memory_order_relaxed) >= max_new_) return true;
+    if (!Place(fingerprint)) return false;
+    uint64_t slot = num_added_.fetch_add(1);
+    if (slot < max_new_) added_[slot] = fingerprint;
+    return true;
+}
+
+bool FingerprintIndex::Contains(uint64_t fingerprint) const {
+    for (uint64_t pos = SplitMix64(fingerprint) & mask_;; pos = (pos + 1) & mask_) {
+        uint64_t current = slots_[pos].load(std::memory_order_acquire);
+        if (current == fingerprint) return true;
+        if (current == 0) return false;
+    }
+}
+
+bool FingerprintIndex::Save() {
+    const uint64_t num_new = NumAdded();
+    std::error_code ec;
+    const bool exists = std::filesystem::exists(path_, ec);
+
+    std::FILE* file = std::fopen(path_.c_str(), exists ? "r+b" : "wb");
+    if (!file) {
+        std::cerr << "Error: Cannot open file " << path_ << std::endl;
+        return false;
+    }
+    FingerprintFileHeader header{};
+    std::memcpy(header.magic, kFingerprintMagic, sizeof(kFingerprintMagic));
+    header.version = kFingerprintVersion;
+
+    // 追加新指纹后回填计数 (计数以文件中实际条目为准)
+    bool ok = true;
+    uint64_t existing = 0;
+    if (exists) {
+        FingerprintFileHeader old{};
+        ok = std::fread(&old, sizeof(old), 1, file) == 1;
+        existing = old.count;
+    } else {
+        ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    }
+    ok = ok && std::fseek(file, static_cast<long>(sizeof(header) + existing * sizeof(uint64_t)),
+                          SEEK_SET) == 0;
+    ok = ok && (num_new == 0 ||
+                std::fwrite(added_.get(), sizeof(uint64_t), num_new, file) == num_new);
+    header.count = existing + num_new;
+    ok = ok && std::fseek(file, 0, SEEK_SET) == 0;
+    ok = ok && std::fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) {
+        std::cerr << "Error: Failed to write fingerprint index " << path_ << std::endl;
+        return false;
+    }
+    num_loaded_ += num_new;
+    num_added_.store(0);
+    return true;
+}
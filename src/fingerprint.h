@@ -0,0 +1,76 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// fingerprint.h - 算例内容指纹与持久化指纹索引
+// 指纹 = 母板尺寸 + 按 (宽度, 长度, 需求) 排序的子板列表的 64 位非加密哈希,
+// 与子板顺序和编号无关: 仅排列不同的算例指纹相同
+//
+// 索引文件布局 (小端):
+//   FingerprintFileHeader
+//   uint64 fingerprints[count]      (只追加, 按插入顺序)
+
+#ifndef CS_2D_DATA_FINGERPRINT_H_
+#define CS_2D_DATA_FINGERPRINT_H_
+
+#include "instance.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// 计算算例的规范指纹 (非 0; 每线程复用排序缓冲区)
+uint64_t ComputeFingerprint(const Instance& inst);
+
+constexpr char kFingerprintMagic[8] = {'C', 'S', '2', 'D', 'F', 'P', 'I', 'X'};
+constexpr uint32_t kFingerprintVersion = 1;
+
+struct FingerprintFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t count;
+};
+
+static_assert(sizeof(FingerprintFileHeader) == 24, "FingerprintFileHeader layout");
+
+// 指纹集合: 载入已有指纹后放入定长开放寻址表, Insert 为无锁 CAS, 每次 O(1)
+class FingerprintIndex {
+public:
+    FingerprintIndex() = default;
+    FingerprintIndex(const FingerprintIndex&) = delete;
+    FingerprintIndex& operator=(const FingerprintIndex&) = delete;
+
+    // 读取索引文件 (不存在则视为空), 并为至多 max_new 个新指纹预留空间
+    bool Open(const std::string& path, uint64_t max_new);
+
+    // 插入指纹; 已存在返回 false (线程安全). 新指纹超过 max_new 个后不再记录, 总返回 true
+    bool Insert(uint64_t fingerprint);
+
+    bool Contains(uint64_t fingerprint) const;
+
+    // 把本次新插入的指纹追加到索引文件
+    bool Save();
+
+    uint64_t NumLoaded() const { return num_loaded_; }
+    uint64_t NumAdded() const { return std::min<uint64_t>(num_added_.load(), max_new_); }
+
+private:
+    std::string path_;
+    std::unique_ptr<std::atomic<uint64_t>[]> slots_;   // 0 = 空槽
+    uint64_t mask_ = 0;
+    uint64_t num_loaded_ = 0;
+    uint64_t max_new_ = 0;
+    std::unique_ptr<uint64_t[]> added_;                 // 新指纹, 按插入顺序
+    std::atomic<uint64_t> num_added_{0};
+
+    // 放入表中; 已存在返回 false
+    bool Place(uint64_t fingerprint);
+};
+
+#endif  // CS_2D_DATA_FINGERPRINT_H_
@@ -0,0 +1,184 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// flat_hash.h - 子板尺寸去重集合
+// 母板足够小时使用 W x L 占用位图, 否则使用开放寻址哈希表;
+// 仅记录被写入的位置, Reset 代价与上次插入数成正比, 可在批量生成中反复复用;
+// 支持删除, 供目标难度调优替换子板尺寸
+
+#ifndef CS_2D_DATA_FLAT_HASH_H_
+#define CS_2D_DATA_FLAT_HASH_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+class SizeSet {
+public:
+    // 位图最大单元数 (2^24 位 = 2 MB)
+    static constexpr uint64_t kMaxBitmapCells = 1ULL << 24;
+
+    // 清空并按母板尺寸与预计元素数选择存储方式
+    void Reset(int stock_width, int stock_length, int expected_count) {
+        for (uint64_t pos : touched_) {
+            if (use_bitmap_) {
+                bitmap_[pos >> 6] &= ~(1ULL << (pos & 63));
+            } else {
+                slots_[pos] = 0;
+            }
+        }
+        touched_.clear();
+        // 位图模式下的越界尺寸未记录槽位, 整表清零 (规模很小)
+        if (use_bitmap_ && hashed_ > 0) {
+            std::fill(slots_.begin(), slots_.end(), 0);
+        }
+        hashed_ = 0;
+        size_ = 0;
+
+        width_ = stock_width;
+        length_ = stock_length;
+        uint64_t cells = static_cast<uint64_t>(width_ + 1) * (length_ + 1);
+        use_bitmap_ = cells <= kMaxBitmapCells;
+        if (use_bitmap_) {
+            if (bitmap_.size() < (cells + 63) / 64) {
+                bitmap_.resize((cells + 63) / 64, 0);
+            }
+        } else {
+            size_t capacity = 16;
+            while (capacity < static_cast<size_t>(expected_count) * 2) capacity <<= 1;
+            if (slots_.size() < capacity) {
+                slots_.assign(capacity, 0);
+            }
+        }
+    }
+
+    // 是否包含尺寸
+    bool Contains(int w, int l) const {
+        if (use_bitmap_ && InStock(w, l)) {
+            uint64_t pos = BitPos(w, l);
+            return (bitmap_[pos >> 6] >> (pos & 63)) & 1;
+        }
+        if (slots_.empty()) return false;
+        uint64_t key = Key(w, l);
+        size_t mask = slots_.size() - 1;
+        for (size_t i = Hash(key) & mask; slots_[i] != 0; i = (i + 1) & mask) {
+            if (slots_[i] == key) return true;
+        }
+        return false;
+    }
+
+    // 插入尺寸, 已存在时返回 false
+    bool Insert(int w, int l) {
+        if (use_bitmap_ && InStock(w, l)) {
+            uint64_t pos = BitPos(w, l);
+            uint64_t bit = 1ULL << (pos & 63);
+            if (bitmap_[pos >> 6] & bit) return false;
+            bitmap_[pos >> 6] |= bit;
+            touched_.push_back(pos);
+            size_++;
+            return true;
+        }
+        // 位图模式下越界尺寸与哈希模式共用哈希表
+        if (use_bitmap_ && slots_.empty()) {
+            slots_.assign(16, 0);
+        }
+        if ((hashed_ + 1) * 2 > slots_.size()) {
+            Grow();
+        }
+        uint64_t key = Key(w, l);
+        size_t mask = slots_.size() - 1;
+        size_t i = Hash(key) & mask;
+        for (; slots_[i] != 0; i = (i + 1) & mask) {
+            if (slots_[i] == key) return false;
+        }
+        slots_[i] = key;
+        if (!use_bitmap_) touched_.push_back(i);
+        hashed_++;
+        size_++;
+        return true;
+    }
+
+    // 删除尺寸, 不存在时返回 false (哈希表按线性探测回移, 不留墓碑)
+    bool Erase(int w, int l) {
+        if (use_bitmap_ && InStock(w, l)) {
+            uint64_t pos = BitPos(w, l);
+            uint64_t bit = 1ULL << (pos & 63);
+            if (!(bitmap_[pos >> 6] & bit)) return false;
+            bitmap_[pos >> 6] &= ~bit;
+            size_--;
+            return true;
+        }
+        if (slots_.empty()) return false;
+        uint64_t key = Key(w, l);
+        size_t mask = slots_.size() - 1;
+        size_t i = Hash(key) & mask;
+        for (; slots_[i] != key; i = (i + 1) & mask) {
+            if (slots_[i] == 0) return false;
+        }
+        // 后继键的起始槽不在 (i, j] 内时前移到空位; 前移目标槽原本非空, 已记入 touched_
+        for (size_t j = (i + 1) & mask; slots_[j] != 0; j = (j + 1) & mask) {
+            size_t home = Hash(slots_[j]) & mask;
+            bool stays = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+            if (stays) continue;
+            slots_[i] = slots_[j];
+            i = j;
+        }
+        slots_[i] = 0;
+        hashed_--;
+        size_--;
+        return true;
+    }
+
+    // 元素个数
+    int Size() const { return size_; }
+
+private:
+    int width_ = 0;
+    int length_ = 0;
+    bool use_bitmap_ = true;
+    int size_ = 0;
+    size_t hashed_ = 0;
+    std::vector<uint64_t> bitmap_;      // 占用位图
+    std::vector<uint64_t> slots_;       // 开放寻址槽 (0=空)
+    std::vector<uint64_t> touched_;     // 已写入的位图位/槽位
+
+    bool InStock(int w, int l) const {
+        return w >= 0 && l >= 0 && w <= width_ && l <= length_;
+    }
+
+    uint64_t BitPos(int w, int l) const {
+        return static_cast<uint64_t>(w) * (length_ + 1) + l;
+    }
+
+    static uint64_t Key(int w, int l) {
+        return ((static_cast<uint64_t>(static_cast<uint32_t>(w)) << 32)
+                | static_cast<uint32_t>(l)) + 1;
+    }
+
+    static size_t Hash(uint64_t key) {
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 20);
+    }
+
+    // 扩容并重新插入 (越界尺寸仅在位图模式下出现, 规模很小)
+    void Grow() {
+        std::vector<uint64_t> old;
+        old.swap(slots_);
+        slots_.assign(old.empty() ? 16 : old.size() * 2, 0);
+        if (!use_bitmap_) touched_.clear();
+        size_t mask = slots_.size() - 1;
+        for (uint64_t key : old) {
+            if (key == 0) continue;
+            size_t i = Hash(key) & mask;
+            while (slots_[i] != 0) i = (i + 1) & mask;
+            slots_[i] = key;
+            if (!use_bitmap_) touched_.push_back(i);
+        }
+    }
+};
+
+#endif  // CS_2D_DATA_FLAT_HASH_H_
@@ -10,22 +10,116 @@
 // 实现四种生成策略: 逆向/随机/聚类/残差
 
 #include "generator.h"
-#include <fstream>
+#include "incremental_stats.h"
+#include "csv_io.h"
+#include "fingerprint.h"
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
 #include <chrono>
-#include <thread>
-#include <set>
-#include <map>
 #include <iostream>
 #include <filesystem>
+#include <climits>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <tuple>
+#include <type_traits>
 
 // 小质数表, 用于质数偏移生成
 static const int kPrimes[] = {7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47};
 static const int kNumPrimes = sizeof(kPrimes) / sizeof(kPrimes[0]);
 
+namespace {
+
+// 一组参数下的子板尺寸抽样范围 (只依赖参数, 批量抽样时每批计算一次)
+struct ItemSizeBounds {
+    int W, L;
+    int min_w, max_w;           // 宽度范围
+    int area_min, area_max;     // 整数面积范围 (长度范围 = 面积 / 宽度)
+    double min_area, max_area;
+
+    explicit ItemSizeBounds(const GeneratorParams& params)
+        : W(params.stock_width), L(params.stock_length) {
+        // 计算尺寸范围 (基于面积比)
+        double stock_area = static_cast<double>(W * L);
+        min_area = stock_area * params.min_size_ratio;
+        max_area = stock_area * params.max_size_ratio;
+
+        min_w = static_cast<int>(std::sqrt(min_area * 0.5));
+        max_w = static_cast<int>(std::sqrt(max_area * 2.0));
+        min_w = std::max(5, std::min(min_w, W - 1));
+        max_w = std::min(max_w, W);
+
+        area_min = static_cast<int>(min_area);
+        area_max = static_cast<int>(max_area);
+    }
+};
+
+// 批量抽样的块大小 (块内随机字 + SoA 结果约 6 KB, 留在 L1)
+constexpr int kSizeBlock = 128;
+
+// Lemire 取高位: 与 UniformInt 的首次抽取相同; 低位 < range 时可能需要拒绝重抽, 由调用方回退
+inline uint32_t LemireHigh(uint64_t word, uint32_t range, uint32_t& low_ok) {
+    const uint64_t m = (word >> 32) * range;
+    low_ok &= static_cast<uint32_t>(static_cast<uint32_t>(m) >= range);
+    return static_cast<uint32_t>(m >> 32);
+}
+
+// 对一块预先抽取的随机字计算子板尺寸 (各循环无分支, 可被编译器向量化)
+// 返回第一个可能需要拒绝重抽的子板序号 (全部有效则返回 n), 该子板及其后的结果作废
+template <bool kPrimeOffset>
+int SampleItemSizeBlock(const ItemSizeBounds& b, const uint64_t* bits, int n, int* w, int* l) {
+    const uint64_t* bits_w = bits;
+    const uint64_t* bits_l = bits + kSizeBlock;
+    const uint64_t* bits_p = bits + 2 * kSizeBlock;
+    const uint64_t* bits_s = bits + 3 * kSizeBlock;
+    uint32_t ok[kSizeBlock];
+
+    const uint32_t range_w = static_cast<uint32_t>(b.max_w - b.min_w + 1);
+    for (int i = 0; i < n; i++) {
+        ok[i] = 1;
+        w[i] = b.min_w + static_cast<int>(LemireHigh(bits_w[i], range_w, ok[i]));
+    }
+
+    // 长度范围; 双精度除法截断与整数除法一致 (被除数 < 2^31, 商的舍入误差远小于 1/除数)
+    const double area_min = b.area_min;
+    const double area_max = b.area_max;
+    for (int i = 0; i < n; i++) {
+        const double width = w[i];
+        int l_min = std::max(5, static_cast<int>(area_min / width));
+        int l_max = std::min(b.L, static_cast<int>(area_max / width));
+        l_max = std::max(l_min, l_max);
+        const uint32_t range_l = static_cast<uint32_t>(l_max - l_min + 1);
+        l[i] = l_min + static_cast<int>(LemireHigh(bits_l[i], range_l, ok[i]));
+    }
+
+    // 质数偏移
+    if constexpr (kPrimeOffset) {
+        for (int i = 0; i < n; i++) {
+            const int prime = kPrimes[LemireHigh(bits_p[i], kNumPrimes, ok[i])];
+            const int offset = LemireHigh(bits_s[i], 2, ok[i]) ? prime : -prime;
+            w[i] = std::clamp(w[i] + offset / 2, b.min_w, b.max_w);
+            l[i] = std::clamp(l[i] + offset, 5, b.L);
+        }
+    }
+
+    // 确保 length >= width
+    for (int i = 0; i < n; i++) {
+        const int lo = std::min(w[i], l[i]);
+        const int hi = std::max(w[i], l[i]);
+        w[i] = lo;
+        l[i] = hi;
+    }
+
+    for (int i = 0; i < n; i++) {
+        if (!ok[i]) return i;
+    }
+    return n;
+}
+
+}  // namespace
+
 // 从预设创建参数
 GeneratorParams GeneratorParams::FromPreset(Preset preset) {
     GeneratorParams p;
@@ -83,9 +177,122 @@ GeneratorParams GeneratorParams::FromPreset(Preset preset) {
     return p;
 }
 
+// 从单难度参数创建参数
+GeneratorParams GeneratorParams::FromLegacy(double difficulty,
+    int stock_width, int stock_length) {
+    // 将0-1难度值映射到新参数
+    difficulty = std::clamp(difficulty, 0.0, 1.0);
+
+    GeneratorParams params;
+    params.stock_width = stock_width;
+    params.stock_length = stock_length;
+    params.num_types = 5 + static_cast<int>(difficulty * 35);
+    params.min_size_ratio = 0.08 + difficulty * 0.07;
+    params.max_size_ratio = 0.35 + difficulty * 0.15;
+    params.min_demand = std::max(1, 6 - static_cast<int>(difficulty * 5));
+    params.max_demand = std::max(3, 30 - static_cast<int>(difficulty * 27));
+    params.size_cv = 0.15 + difficulty * 0.35;
+    params.demand_skew = difficulty * 0.5;
+    params.prime_offset = (difficulty > 0.5);
+
+    if (difficulty < 0.3) params.strategy = 0;
+    else if (difficulty < 0.8) params.strategy = 1;
+    else params.strategy = 3;
+
+    return params;
+}
+
+namespace {
+
+bool ParseIntValue(const std::string& s, int& value) {
+    if (s.empty()) return false;
+    char* end = nullptr;
+    long v = std::strtol(s.c_str(), &end, 10);
+    if (*end != '\0' || v < INT_MIN || v > INT_MAX) return false;
+    value = static_cast<int>(v);
+    return true;
+}
+
+bool ParseDoubleValue(const std::string& s, double& value) {
+    if (s.empty()) return false;
+    char* end = nullptr;
+    value = std::strtod(s.c_str(), &end);
+    return *end == '\0';
+}
+
+bool ParseBoolValue(const std::string& s, bool& value) {
+    if (s == "1" || s == "true" || s == "yes") { value = true; return true; }
+    if (s == "0" || s == "false" || s == "no") { value = false; return true; }
+    return false;
+}
+
+}  // namespace
+
+// 按键名设置参数
+bool GeneratorParams::Set(const std::string& key, const std::string& value) {
+    if (key == "preset") {
+        Preset preset;
+        if (value == "easy") preset = Preset::kEasy;
+        else if (value == "medium") preset = Preset::kMedium;
+        else if (value == "hard") preset = Preset::kHard;
+        else if (value == "expert") preset = Preset::kExpert;
+        else return false;
+        GeneratorParams p = FromPreset(preset);
+        p.stock_width = stock_width;
+        p.stock_length = stock_length;
+        p.seed = seed;
+        p.large_scale = large_scale;
+        *this = p;
+        return true;
+    }
+    if (key == "num_types") return ParseIntValue(value, num_types);
+    if (key == "stock_width") return ParseIntValue(value, stock_width);
+    if (key == "stock_length") return ParseIntValue(value, stock_length);
+    if (key == "min_size_ratio") return ParseDoubleValue(value, min_size_ratio);
+    if (key == "max_size_ratio") return ParseDoubleValue(value, max_size_ratio);
+    if (key == "size_cv") return ParseDoubleValue(value, size_cv);
+    if (key == "min_demand") return ParseIntValue(value, min_demand);
+    if (key == "max_demand") return ParseIntValue(value, max_demand);
+    if (key == "demand_skew") return ParseDoubleValue(value, demand_skew);
+    if (key == "prime_offset") return ParseBoolValue(value, prime_offset);
+    if (key == "num_clusters") return ParseIntValue(value, num_clusters);
+    if (key == "peak_ratio") return ParseDoubleValue(value, peak_ratio);
+    if (key == "large_scale") return ParseBoolValue(value, large_scale);
+    if (key == "strategy") return ParseIntValue(value, strategy);
+    if (key == "seed") return ParseIntValue(value, seed);
+    return false;
+}
+
+// 全部参数的键值列表
+std::vector<std::pair<std::string, std::string>> GeneratorParams::ToKeyValues() const {
+    auto real = [](double v) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%.17g", v);
+        return std::string(buf);
+    };
+    return {
+        {"num_types", std::to_string(num_types)},
+        {"stock_width", std::to_string(stock_width)},
+        {"stock_length", std::to_string(stock_length)},
+        {"min_size_ratio", real(min_size_ratio)},
+        {"max_size_ratio", real(max_size_ratio)},
+        {"size_cv", real(size_cv)},
+        {"min_demand", std::to_string(min_demand)},
+        {"max_demand", std::to_string(max_demand)},
+        {"demand_skew", real(demand_skew)},
+        {"prime_offset", prime_offset ? "1" : "0"},
+        {"num_clusters", std::to_string(num_clusters)},
+        {"peak_ratio", real(peak_ratio)},
+        {"large_scale", large_scale ? "1" : "0"},
+        {"strategy", std::to_string(strategy)},
+        {"seed", std::to_string(seed)},
+    };
+}
+
 // 参数有效性检查
 bool GeneratorParams::Validate() const {
-    if (num_types < 3 || num_types > 200) return false;
+    int max_types = large_scale ? kMaxLargeScaleTypes : kMaxTypes;
+    if (num_types < 3 || num_types > max_types) return false;
     if (stock_width < 50 || stock_length < 50) return false;
     if (min_size_ratio < 0.01 || min_size_ratio > 0.50) return false;
     if (max_size_ratio < min_size_ratio || max_size_ratio > 0.80) return false;
@@ -108,15 +315,19 @@ std::string GeneratorParams::GetSummary() const {
        << "  需求偏斜度: " << demand_skew << "\n"
        << "  质数偏移: " << (prime_offset ? "是" : "否") << "\n"
        << "  生成策略: " << strategy << "\n";
+    if (large_scale) {
+        ss << "  大规模模式: 是\n";
+    }
     return ss.str();
 }
 
 // 构造函数
-InstanceGenerator::InstanceGenerator() {
-    SetSeed(0);
-}
+InstanceGenerator::InstanceGenerator() : InstanceGenerator(0) {}
 
-InstanceGenerator::InstanceGenerator(int seed) {
+InstanceGenerator::InstanceGenerator(int seed, RngEngine engine) : engine_(engine) {
+    if (engine_ == RngEngine::kMt19937) {
+        rng_.emplace<std::mt19937>();
+    }
     SetSeed(seed);
 }
 
@@ -125,55 +336,110 @@ void InstanceGenerator::SetSeed(int seed) {
         seed = static_cast<int>(
             std::chrono::system_clock::now().time_since_epoch().count() & 0x7FFFFFFF);
     }
-    rng_.seed(static_cast<unsigned int>(seed));
+    std::visit([seed](auto& rng) { rng.seed(static_cast<unsigned int>(seed)); }, rng_);
+}
+
+void InstanceGenerator::SetStreamSeed(uint64_t stream_seed) {
+    if (auto* mt = std::get_if<std::mt19937>(&rng_)) {
+        SeedSeq2 seq(stream_seed);
+        mt->seed(seq);
+    } else {
+        std::get<Xoshiro256StarStar>(rng_).seed(stream_seed);
+    }
+}
+
+int InstanceGenerator::DrawSeed() {
+    return std::visit([](auto& rng) {
+        return static_cast<int>(rng() & 0x7FFFFFFF) | 1;
+    }, rng_);
 }
 
 // 主生成函数
 GenerationResult InstanceGenerator::Generate(const GeneratorParams& params) {
     GenerationResult result;
-    result.success = false;
+    GenerateInto(params, result);
+    return result;
+}
 
-    // 参数检查
-    if (!params.Validate()) {
-        result.error_message = "Invalid parameters";
-        return result;
-    }
+// 生成批内第index个算例
+GenerationResult InstanceGenerator::Generate(const GeneratorParams& params,
+    uint64_t index) {
+    GenerationResult result;
+    GenerateInto(params, index, result);
+    return result;
+}
 
+// 写入调用方持有的结果
+bool InstanceGenerator::GenerateInto(const GeneratorParams& params, GenerationResult& out) {
     // 设置随机种子
     if (params.seed != 0) {
         SetSeed(params.seed);
     }
+    return GenerateFromCurrentStream(params, out);
+}
 
-    // 根据策略选择生成方法
-    Instance inst;
-    switch (params.strategy) {
-        case 0:
-            inst = GenerateReverse(params);
-            break;
-        case 1:
-            inst = GenerateRandom(params);
-            break;
-        case 2:
-            inst = GenerateCluster(params);
-            break;
-        case 3:
-            inst = GenerateResidual(params);
-            break;
-        default:
-            inst = GenerateRandom(params);
+bool InstanceGenerator::GenerateInto(const GeneratorParams& params, uint64_t index,
+    GenerationResult& out, uint32_t attempt) {
+    SetStreamSeed(DeriveAttemptSeed(static_cast<uint32_t>(params.seed), index, attempt));
+    return GenerateFromCurrentStream(params, out);
+}
+
+// 使用当前随机流生成算例
+bool InstanceGenerator::GenerateFromCurrentStream(const GeneratorParams& params,
+    GenerationResult& result) {
+    result.success = false;
+    result.error_message.clear();
+    result.iterations = 0;
+    result.elapsed_ms = 0.0;
+
+    // 参数检查
+    if (!params.Validate()) {
+        result.error_message = "Invalid parameters";
+        return false;
     }
 
-    // 验证并修正
-    if (!ValidateAndFix(inst, params)) {
+    // 分派引擎 (每个算例一次), 按策略原地生成并验证修正
+    bool valid = std::visit([&](auto& rng) {
+        return GenerateWithEngine(rng, params, result.instance);
+    }, rng_);
+    if (!valid) {
         result.error_message = "Failed to generate valid instance";
-        return result;
+        return false;
     }
 
     // 难度预估
-    result.instance = inst;
-    result.estimate = estimator_.Estimate(inst);
+    EstimateResult(result);
     result.success = true;
-    return result;
+    return true;
+}
+
+void InstanceGenerator::EstimateResult(GenerationResult& result) {
+    CS2D_TIME_SCOPE(counters_.estimate_ns);
+    result.estimate = estimator_.Estimate(result.instance);
+    result.bounds = bounds_.ComputeLower(result.instance);
+}
+
+int InstanceGenerator::ComputeUpperBound(GenerationResult& result) {
+    result.bounds.upper = bounds_.ComputeUpper(result.instance);
+    return result.bounds.upper;
+}
+
+// 目标难度生成
+GenerationResult InstanceGenerator::GenerateTargeted(const GeneratorParams& params,
+    double target_score, double tolerance, int max_iterations) {
+    if (params.seed != 0) {
+        SetSeed(params.seed);
+    }
+    return GenerateTargetedFromCurrentStream(params, target_score, tolerance,
+                                             max_iterations);
+}
+
+GenerationResult InstanceGenerator::GenerateTargeted(const GeneratorParams& params,
+    uint64_t index, double target_score, double tolerance, int max_iterations,
+    uint32_t attempt) {
+    SetStreamSeed(DeriveAttemptSeed(static_cast<uint32_t>(params.seed), index, attempt));
+    return GenerateTargetedFromCurrentStream(params, target_score, tolerance,
+                                             max_iterations);
 }
 
 // 快捷生成 (使用预设)
@@ -184,119 +450,196 @@ GenerationResult InstanceGenerator::Generate(Preset preset) {
 // 兼容旧接口
 GenerationResult InstanceGenerator::GenerateLegacy(double difficulty,
     int stock_width, int stock_length) {
-    // 将0-1难度值映射到新参数
-    difficulty = std::clamp(difficulty, 0.0, 1.0);
+    return Generate(GeneratorParams::FromLegacy(difficulty, stock_width, stock_length));
+}
 
-    GeneratorParams params;
-    params.stock_width = stock_width;
-    params.stock_length = stock_length;
-    params.num_types = 5 + static_cast<int>(difficulty * 35);
-    params.min_size_ratio = 0.08 + difficulty * 0.07;
-    params.max_size_ratio = 0.35 + difficulty * 0.15;
-    params.min_demand = std::max(1, 6 - static_cast<int>(difficulty * 5));
-    params.max_demand = std::max(3, 30 - static_cast<int>(difficulty * 27));
-    params.size_cv = 0.15 + difficulty * 0.35;
-    params.demand_skew = difficulty * 0.5;
-    params.prime_offset = (difficulty > 0.5);
+// 按参数重置算例 (清空子板列表但保留容量)
+static void ResetInstance(Instance& inst, const GeneratorParams& params) {
+    inst.stock_width = params.stock_width;
+    inst.stock_length = params.stock_length;
+    inst.known_optimal = -1;
+    inst.difficulty = 0.0;
+    inst.items.clear();
+    inst.certificate.Clear();
+    inst.fingerprint = 0;
+    inst.items.reserve(params.num_types);
+    inst.InvalidateStats();
+}
 
-    if (difficulty < 0.3) params.strategy = 0;
-    else if (difficulty < 0.8) params.strategy = 1;
-    else params.strategy = 3;
+// 按策略生成并验证修正
+template <typename Engine>
+bool InstanceGenerator::GenerateWithEngine(Engine& rng, const GeneratorParams& params,
+    Instance& inst) {
+    CS2D_COUNT(counters_.instances, 1);
+    {
+        CS2D_TIME_SCOPE(counters_.generate_ns);
+        GenerateDispatch(rng, params, inst);
+    }
+
+    // 验证并修正
+    return ValidateAndFix(rng, inst, params);
+}
 
-    return Generate(params);
+// 按参数选择特化生成核 (每个算例一次)
+template <typename Engine>
+void InstanceGenerator::GenerateDispatch(Engine& rng, const GeneratorParams& params,
+    Instance& inst) {
+    const bool skewed = params.demand_skew >= 0.01;
+    if (params.prime_offset) {
+        if (skewed) {
+            GenerateKernel<PrimeOffset::kOn, DemandSkew::kSkewed>(rng, params, inst);
+        } else {
+            GenerateKernel<PrimeOffset::kOn, DemandSkew::kUniform>(rng, params, inst);
+        }
+    } else {
+        if (skewed) {
+            GenerateKernel<PrimeOffset::kOff, DemandSkew::kSkewed>(rng, params, inst);
+        } else {
+            GenerateKernel<PrimeOffset::kOff, DemandSkew::kUniform>(rng, params, inst);
+        }
+    }
+}
+
+// 根据策略选择生成方法
+template <InstanceGenerator::PrimeOffset kPrime, InstanceGenerator::DemandSkew kSkew,
+          typename Engine>
+void InstanceGenerator::GenerateKernel(Engine& rng, const GeneratorParams& params,
+    Instance& inst) {
+    switch (params.strategy) {
+        case 0:
+            GenerateReverse<kPrime>(rng, params, inst);
+            break;
+        case 1:
+            GenerateRandom<kPrime, kSkew>(rng, params, inst);
+            break;
+        case 2:
+            GenerateCluster<kPrime, kSkew>(rng, params, inst);
+            break;
+        case 3:
+            GenerateResidual<kSkew>(rng, params, inst);
+            break;
+        default:
+            GenerateRandom<kPrime, kSkew>(rng, params, inst);
+    }
 }
 
 // 策略0: 逆向生成 (构造完美填充, 已知最优解)
-Instance InstanceGenerator::GenerateReverse(const GeneratorParams& params) {
-    Instance inst;
-    inst.stock_width = params.stock_width;
-    inst.stock_length = params.stock_length;
-    inst.known_optimal = -1;
+template <InstanceGenerator::PrimeOffset kPrime, typename Engine>
+void InstanceGenerator::GenerateReverse(Engine& rng, const GeneratorParams& params,
+    Instance& inst) {
+    ResetInstance(inst, params);
 
     int W = params.stock_width;
     int L = params.stock_length;
 
     // 决定母板数量 (即最优解)
-    std::uniform_int_distribution<int> num_stocks_dist(3, 8);
-    int num_stocks = num_stocks_dist(rng_);
+    int num_stocks = UniformInt(rng, 3, 8);
     inst.known_optimal = num_stocks;
 
     // 生成基础子板尺寸
-    std::vector<std::pair<int, int>> base_sizes;
+    auto& base_sizes = scratch_.base_sizes;
+    auto& size_w = scratch_.size_w;
+    auto& size_l = scratch_.size_l;
+    size_w.resize(params.num_types);
+    size_l.resize(params.num_types);
+    GenerateItemSizes<kPrime>(rng, params, params.num_types, size_w.data(), size_l.data());
+    base_sizes.clear();
     for (int i = 0; i < params.num_types; i++) {
-        auto size = GenerateItemSize(params);
-        base_sizes.push_back(size);
+        base_sizes.emplace_back(size_w[i], size_l[i]);
     }
 
-    // 统计每种子板需求量
-    std::map<std::pair<int, int>, int> demand_map;
+    // 统计每种基础类型的需求量 (扁平表, 按类型序号索引)
+    auto& type_demand = scratch_.type_demand;
+    type_demand.assign(params.num_types, 0);
 
-    // 对每张母板进行贪心填充
+    // 宽度索引 (每个算例构建一次)
+    WidthIndex& index = scratch_.width_index;
+    index.Build(base_sizes);
+
+    // 对每张母板进行贪心填充, 同时记录装箱方案 (子板暂记基础类型序号)
+    PackingCertificate& cert = inst.certificate;
     for (int s = 0; s < num_stocks; s++) {
         int remaining_width = W;
 
         // Stage1: 沿宽度方向切条带
         while (remaining_width > 0) {
             // 随机选择子板宽度作为条带宽度
-            std::uniform_int_distribution<int> type_dist(0, params.num_types - 1);
-            int type_idx = type_dist(rng_);
+            int type_idx = UniformInt(rng, 0, params.num_types - 1);
             int strip_width = base_sizes[type_idx].first;
 
-            // 如果放不下, 找一个能放的
+            // 如果放不下, 找一个能放的 (序号最小的可放入类型)
             if (strip_width > remaining_width) {
-                bool found = false;
-                for (int i = 0; i < params.num_types; i++) {
-                    if (base_sizes[i].first <= remaining_width) {
-                        strip_width = base_sizes[i].first;
-                        type_idx = i;
-                        found = true;
-                        break;
-                    }
-                }
-                if (!found) break;
+                type_idx = index.FirstFittingType(remaining_width);
+                if (type_idx < 0) break;
+                strip_width = base_sizes[type_idx].first;
             }
+            int group = index.GroupOf(type_idx);
+            cert.AddStrip(strip_width);
 
             // Stage2: 在条带内沿长度方向切子板
             int remaining_length = L;
             while (remaining_length > 0) {
-                // 找能放入的子板 (宽度匹配)
-                std::vector<int> valid_types;
-                for (int i = 0; i < params.num_types; i++) {
-                    if (base_sizes[i].first == strip_width &&
-                        base_sizes[i].second <= remaining_length) {
-                        valid_types.push_back(i);
-                    }
-                }
-                if (valid_types.empty()) break;
+                // 能放入的子板数 (宽度匹配, 长度不超过剩余长度)
+                int num_valid = index.CountFitting(group, remaining_length);
+                if (num_valid == 0) break;
 
-                std::uniform_int_distribution<int> pick_dist(0,
-                    static_cast<int>(valid_types.size()) - 1);
-                int picked = valid_types[pick_dist(rng_)];
+                int picked = index.KthFitting(group, remaining_length,
+                                              UniformInt(rng, 0, num_valid - 1));
 
-                demand_map[base_sizes[picked]]++;
+                type_demand[picked]++;
+                cert.AddPiece(picked);
                 remaining_length -= base_sizes[picked].second;
             }
 
             remaining_width -= strip_width;
         }
+        cert.CloseStock();
     }
 
-    // 转换为子板列表
+    // 转换为子板列表: 按尺寸排序并合并重复尺寸的基础类型
+    auto& sized_demand = scratch_.sized_demand;
+    sized_demand.clear();
+    for (int t = 0; t < params.num_types; t++) {
+        if (type_demand[t] > 0) {
+            sized_demand.push_back({base_sizes[t], type_demand[t]});
+        }
+    }
+    std::sort(sized_demand.begin(), sized_demand.end());
+
     int id = 0;
-    for (const auto& [size, demand] : demand_map) {
-        if (demand > 0) {
-            Item item;
-            item.id = id++;
-            item.width = size.first;
-            item.length = size.second;
-            item.demand = demand;
-            inst.items.push_back(item);
+    for (size_t k = 0; k < sized_demand.size(); k++) {
+        const auto& size = sized_demand[k].first;
+        int demand = sized_demand[k].second;
+        while (k + 1 < sized_demand.size() && sized_demand[k + 1].first == size) {
+            demand += sized_demand[++k].second;
         }
+        Item item;
+        item.id = id++;
+        item.width = size.first;
+        item.length = size.second;
+        item.demand = demand;
+        inst.items.push_back(item);
+    }
+
+    // 证书中的基础类型序号换成子板编号 (子板按尺寸有序, 二分查找; 需求表复用为映射表)
+    for (int t = 0; t < params.num_types; t++) {
+        if (type_demand[t] == 0) continue;
+        auto it = std::lower_bound(inst.items.begin(), inst.items.end(), base_sizes[t],
+            [](const Item& item, const std::pair<int, int>& size) {
+                return std::make_pair(item.width, item.length) < size;
+            });
+        type_demand[t] = it->id;
+    }
+    for (int& piece : cert.piece_ids) {
+        piece = type_demand[piece];
     }
 
     // 保证最少3种子板
+    if (static_cast<int>(inst.items.size()) < 3) {
+        CS2D_COUNT(counters_.optimal_lost, 1);
+    }
     while (static_cast<int>(inst.items.size()) < 3) {
-        auto size = GenerateItemSize(params);
+        auto size = GenerateItemSize<kPrime>(rng, params);
         Item item;
         item.id = id++;
         item.width = size.first;
@@ -304,61 +647,72 @@ Instance InstanceGenerator::GenerateReverse(const GeneratorParams& params) {
         item.demand = 1;
         inst.items.push_back(item);
         inst.known_optimal = -1;  // 不再确定最优解
+        inst.certificate.Clear();
     }
 
-    return inst;
 }
 
 // 策略1: 参数化随机生成
-Instance InstanceGenerator::GenerateRandom(const GeneratorParams& params) {
-    Instance inst;
-    inst.stock_width = params.stock_width;
-    inst.stock_length = params.stock_length;
-    inst.known_optimal = -1;
+template <InstanceGenerator::PrimeOffset kPrime, InstanceGenerator::DemandSkew kSkew,
+          typename Engine>
+void InstanceGenerator::GenerateRandom(Engine& rng, const GeneratorParams& params,
+    Instance& inst) {
+    ResetInstance(inst, params);
 
-    std::set<std::pair<int, int>> used_sizes;
+    SizeSet& used_sizes = scratch_.size_set;
+    used_sizes.Reset(params.stock_width, params.stock_length, params.num_types);
 
-    // 确定热门子板数量
+    // 确定热门子板数量; 热门与普通子板分两段生成, 各段的需求分布在编译期确定
     int num_peak = static_cast<int>(params.num_types * params.peak_ratio);
+    num_peak = std::clamp(num_peak, 0, params.num_types);
 
-    for (int i = 0; i < params.num_types; i++) {
-        int w, l;
-        int attempts = 0;
-        const int max_attempts = 50;
-
-        // 尝试生成不重复的尺寸
-        do {
-            auto size = GenerateItemSize(params);
-            w = size.first;
-            l = size.second;
-            attempts++;
-        } while (used_sizes.count({w, l}) && attempts < max_attempts);
+    auto generate_types = [&](int begin, int end, auto is_peak) {
+        for (int i = begin; i < end; i++) {
+            int w, l;
+            int attempts = 0;
+            const int max_attempts = 50;
 
-        if (attempts >= max_attempts) continue;
-        used_sizes.insert({w, l});
+            // 尝试生成不重复的尺寸
+            do {
+                auto size = GenerateItemSize<kPrime>(rng, params);
+                w = size.first;
+                l = size.second;
+                attempts++;
+            } while (used_sizes.Contains(w, l) && attempts < max_attempts);
+
+            CS2D_COUNT(counters_.size_attempts, attempts);
+            CS2D_COUNT(counters_.size_collisions,
+                       used_sizes.Contains(w, l) ? attempts : attempts - 1);
+            if (attempts >= max_attempts) {
+                CS2D_COUNT(counters_.dropped_types, 1);
+                continue;
+            }
+            used_sizes.Insert(w, l);
 
-        Item item;
-        item.id = i;
-        item.width = w;
-        item.length = l;
-        item.demand = GenerateDemand(params, i < num_peak);
-        inst.items.push_back(item);
-    }
+            Item item;
+            item.id = i;
+            item.width = w;
+            item.length = l;
+            item.demand = GenerateDemand<kSkew>(rng, params, decltype(is_peak)::value);
+            inst.items.push_back(item);
+        }
+    };
+    generate_types(0, num_peak, std::true_type());
+    generate_types(num_peak, params.num_types, std::false_type());
 
     // 重新编号
     for (int i = 0; i < static_cast<int>(inst.items.size()); i++) {
         inst.items[i].id = i;
     }
 
-    return inst;
 }
 
 // 策略2: 聚类生成 (尺寸分群)
-Instance InstanceGenerator::GenerateCluster(const GeneratorParams& params) {
-    Instance inst;
-    inst.stock_width = params.stock_width;
-    inst.stock_length = params.stock_length;
-    inst.known_optimal = -1;
+template <InstanceGenerator::PrimeOffset kPrime, InstanceGenerator::DemandSkew kSkew,
+          typename Engine>
+void InstanceGenerator::GenerateCluster(Engine& rng, const GeneratorParams& params,
+    Instance& inst) {
+    ResetInstance(inst, params);
 
     int W = params.stock_width;
     int L = params.stock_length;
@@ -366,22 +720,27 @@ Instance InstanceGenerator::GenerateCluster(const GeneratorParams& params) {
     // 确定聚类数 (默认3-5个)
     int num_clusters = params.num_clusters;
     if (num_clusters <= 0) {
-        std::uniform_int_distribution<int> cluster_dist(3, 5);
-        num_clusters = cluster_dist(rng_);
+        num_clusters = UniformInt(rng, 3, 5);
     }
 
     // 生成聚类中心
-    std::vector<std::pair<int, int>> centers;
+    auto& centers = scratch_.centers;
+    auto& size_w = scratch_.size_w;
+    auto& size_l = scratch_.size_l;
+    size_w.resize(num_clusters);
+    size_l.resize(num_clusters);
+    GenerateItemSizes<kPrime>(rng, params, num_clusters, size_w.data(), size_l.data());
+    centers.clear();
     for (int c = 0; c < num_clusters; c++) {
-        auto center = GenerateItemSize(params);
-        centers.push_back(center);
+        centers.emplace_back(size_w[c], size_l[c]);
     }
 
     // 每个聚类分配的子板数量
     int per_cluster = params.num_types / num_clusters;
     int remainder = params.num_types % num_clusters;
 
-    std::set<std::pair<int, int>> used_sizes;
+    SizeSet& used_sizes = scratch_.size_set;
+    used_sizes.Reset(params.stock_width, params.stock_length, params.num_types);
     int id = 0;
 
     for (int c = 0; c < num_clusters; c++) {
@@ -400,87 +759,87 @@ Instance InstanceGenerator::GenerateCluster(const GeneratorParams& params) {
 
             do {
                 // 围绕聚类中心生成
-                std::uniform_int_distribution<int> w_dist(
-                    std::max(1, center_w - var_w), center_w + var_w);
-                std::uniform_int_distribution<int> l_dist(
-                    std::max(1, center_l - var_l), center_l + var_l);
-                w = std::min(w_dist(rng_), W);
-                l = std::min(l_dist(rng_), L);
+                w = std::min(UniformInt(rng,
+                    std::max(1, center_w - var_w), center_w + var_w), W);
+                l = std::min(UniformInt(rng,
+                    std::max(1, center_l - var_l), center_l + var_l), L);
                 attempts++;
-            } while (used_sizes.count({w, l}) && attempts < 30);
-
-            if (attempts >= 30) continue;
-            used_sizes.insert({w, l});
+            } while (used_sizes.Contains(w, l) && attempts < 30);
+
+            CS2D_COUNT(counters_.size_attempts, attempts);
+            CS2D_COUNT(counters_.size_collisions,
+                       used_sizes.Contains(w, l) ? attempts : attempts - 1);
+            if (attempts >= 30) {
+                CS2D_COUNT(counters_.dropped_types, 1);
+                continue;
+            }
+            used_sizes.Insert(w, l);
 
             Item item;
             item.id = id++;
             item.width = w;
             item.length = l;
-            item.demand = GenerateDemand(params, false);
+            item.demand = GenerateDemand<kSkew>(rng, params, false);
             inst.items.push_back(item);
         }
     }
 
-    return inst;
 }
 
 // 策略3: 残差生成 (难以完美填充)
-Instance InstanceGenerator::GenerateResidual(const GeneratorParams& params) {
-    Instance inst;
-    inst.stock_width = params.stock_width;
-    inst.stock_length = params.stock_length;
-    inst.known_optimal = -1;
+template <InstanceGenerator::DemandSkew kSkew, typename Engine>
+void InstanceGenerator::GenerateResidual(Engine& rng, const GeneratorParams& params,
+    Instance& inst) {
+    ResetInstance(inst, params);
 
     int W = params.stock_width;
     int L = params.stock_length;
 
-    std::set<std::pair<int, int>> used_sizes;
+    SizeSet& used_sizes = scratch_.size_set;
+    used_sizes.Reset(params.stock_width, params.stock_length, params.num_types);
     int id = 0;
 
     for (int i = 0; i < params.num_types; i++) {
         // 使用质数偏移生成"不友好"尺寸
-        int w = GeneratePrimeOffsetSize(W, params.min_size_ratio, params.max_size_ratio);
-        int l = GeneratePrimeOffsetSize(L, params.min_size_ratio, params.max_size_ratio);
+        int w = GeneratePrimeOffsetSize(rng, W, params.min_size_ratio, params.max_size_ratio);
+        int l = GeneratePrimeOffsetSize(rng, L, params.min_size_ratio, params.max_size_ratio);
 
         // 如果尺寸重复, 略微调整
         int attempts = 0;
-        while (used_sizes.count({w, l}) && attempts < 20) {
+        while (used_sizes.Contains(w, l) && attempts < 20) {
             w = std::min(w + 1, W);
             l = std::min(l + 1, L);
             attempts++;
         }
-        if (used_sizes.count({w, l})) continue;
-        used_sizes.insert({w, l});
+        CS2D_COUNT(counters_.size_attempts, attempts + 1);
+        CS2D_COUNT(counters_.size_collisions, attempts + (used_sizes.Contains(w, l) ? 1 : 0));
+        if (used_sizes.Contains(w, l)) {
+            CS2D_COUNT(counters_.dropped_types, 1);
+            continue;
+        }
+        used_sizes.Insert(w, l);
 
         Item item;
         item.id = id++;
         item.width = w;
         item.length = l;
         // 残差算例需求量通常较小
-        item.demand = GenerateDemand(params, false);
+        item.demand = GenerateDemand<kSkew>(rng, params, false);
         inst.items.push_back(item);
     }
 
-    return inst;
 }
 
 // 生成单个子板尺寸
-std::pair<int, int> InstanceGenerator::GenerateItemSize(
+template <InstanceGenerator::PrimeOffset kPrime, typename Engine>
+std::pair<int, int> InstanceGenerator::GenerateItemSize(Engine& rng,
     const GeneratorParams& params, int base_w, int base_l) {
 
-    int W = params.stock_width;
-    int L = params.stock_length;
-
-    // 计算尺寸范围 (基于面积比)
-    double stock_area = static_cast<double>(W * L);
-    double min_area = stock_area * params.min_size_ratio;
-    double max_area = stock_area * params.max_size_ratio;
-
-    // 宽度范围
-    int min_w = static_cast<int>(std::sqrt(min_area * 0.5));
-    int max_w = static_cast<int>(std::sqrt(max_area * 2.0));
-    min_w = std::max(5, std::min(min_w, W - 1));
-    max_w = std::min(max_w, W);
+    const ItemSizeBounds bounds(params);
+    const int W = bounds.W;
+    const int L = bounds.L;
+    const int min_w = bounds.min_w;
+    const int max_w = bounds.max_w;
 
     int w, l;
 
@@ -491,33 +850,26 @@ std::pair<int, int> InstanceGenerator::GenerateItemSize(
         var_w = std::max(3, var_w);
         var_l = std::max(3, var_l);
 
-        std::uniform_int_distribution<int> w_dist(
+        w = UniformInt(rng,
             std::max(min_w, base_w - var_w), std::min(max_w, base_w + var_w));
-        std::uniform_int_distribution<int> l_dist(
+        l = UniformInt(rng,
             std::max(5, base_l - var_l), std::min(L, base_l + var_l));
-        w = w_dist(rng_);
-        l = l_dist(rng_);
     } else {
         // 随机生成
-        std::uniform_int_distribution<int> w_dist(min_w, max_w);
-        w = w_dist(rng_);
+        w = UniformInt(rng, min_w, max_w);
 
         // 根据面积约束计算长度范围
-        int target_area_min = static_cast<int>(min_area);
-        int target_area_max = static_cast<int>(max_area);
-        int l_min = std::max(5, target_area_min / w);
-        int l_max = std::min(L, target_area_max / w);
+        int l_min = std::max(5, bounds.area_min / w);
+        int l_max = std::min(L, bounds.area_max / w);
         l_max = std::max(l_min, l_max);
 
-        std::uniform_int_distribution<int> l_dist(l_min, l_max);
-        l = l_dist(rng_);
+        l = UniformInt(rng, l_min, l_max);
     }
 
-    // 应用质数偏移
-    if (params.prime_offset) {
-        std::uniform_int_distribution<int> prime_idx(0, kNumPrimes - 1);
-        std::uniform_int_distribution<int> sign_dist(0, 1);
-        int offset = kPrimes[prime_idx(rng_)] * (sign_dist(rng_) ? 1 : -1);
+    // 应用质数偏移 (先抽质数再抽符号)
+    if constexpr (kPrime == PrimeOffset::kOn) {
+        int prime = kPrimes[UniformInt(rng, 0, kNumPrimes - 1)];
+        int offset = UniformInt(rng, 0, 1) ? prime : -prime;
         w = std::clamp(w + offset / 2, min_w, max_w);
         l = std::clamp(l + offset, 5, L);
     }
@@ -530,20 +882,100 @@ std::pair<int, int> InstanceGenerator::GenerateItemSize(
     return {w, l};
 }
 
+template <typename Engine>
+std::pair<int, int> InstanceGenerator::GenerateItemSize(Engine& rng,
+    const GeneratorParams& params) {
+    return params.prime_offset ? GenerateItemSize<PrimeOffset::kOn>(rng, params)
+                               : GenerateItemSize<PrimeOffset::kOff>(rng, params);
+}
+
+// 批量生成 n 个子板尺寸, 与逐个调用 GenerateItemSize 的结果和随机流消耗完全一致
+// 每块先顺序抽取全部随机字 (SoA), 再由无分支内核计算; 遇到可能需要拒绝重抽的子板时
+// 恢复引擎状态, 跳过该子板之前已用的随机字, 由标量路径生成该子板后继续
+template <InstanceGenerator::PrimeOffset kPrime, typename Engine>
+void InstanceGenerator::GenerateItemSizes(Engine& rng, const GeneratorParams& params,
+    int n, int* out_w, int* out_l) {
+    const ItemSizeBounds bounds(params);
+    constexpr bool prime_offset = kPrime == PrimeOffset::kOn;
+    constexpr int words = prime_offset ? 4 : 2;    // 每个子板消耗的随机字数
+
+    // mt19937 的标准分布抽样序列无法分块复现; 宽度范围为空时沿用标量路径的行为
+    if constexpr (!std::is_same_v<Engine, Xoshiro256StarStar>) {
+        for (int i = 0; i < n; i++) {
+            std::tie(out_w[i], out_l[i]) = GenerateItemSize<kPrime>(rng, params);
+        }
+        return;
+    } else {
+        if (bounds.max_w < bounds.min_w) {
+            for (int i = 0; i < n; i++) {
+                std::tie(out_w[i], out_l[i]) = GenerateItemSize<kPrime>(rng, params);
+            }
+            return;
+        }
+
+        auto& bits = scratch_.size_bits;
+        bits.resize(4 * kSizeBlock);
+
+        int i = 0;
+        while (i < n) {
+            const int block = std::min(kSizeBlock, n - i);
+            const Engine saved = rng;
+            for (int j = 0; j < block; j++) {
+                bits[j] = rng();
+                bits[kSizeBlock + j] = rng();
+                if constexpr (prime_offset) {
+                    bits[2 * kSizeBlock + j] = rng();
+                    bits[3 * kSizeBlock + j] = rng();
+                }
+            }
+
+            const int valid = SampleItemSizeBlock<prime_offset>(bounds, bits.data(), block,
+                                                                out_w + i, out_l + i);
+            if (valid < block) {
+                rng = saved;
+                for (int j = 0; j < valid * words; j++) rng();
+                std::tie(out_w[i + valid], out_l[i + valid]) =
+                    GenerateItemSize<kPrime>(rng, params);
+                i += valid + 1;
+            } else {
+                i += block;
+            }
+        }
+    }
+}
+
+void InstanceGenerator::GenerateItemSizes(const GeneratorParams& params, int n,
+    int* out_w, int* out_l) {
+    std::visit([&](auto& rng) {
+        if (params.prime_offset) {
+            GenerateItemSizes<PrimeOffset::kOn>(rng, params, n, out_w, out_l);
+        } else {
+            GenerateItemSizes<PrimeOffset::kOff>(rng, params, n, out_w, out_l);
+        }
+    }, rng_);
+}
+
+void InstanceGenerator::GenerateItemSizesScalar(const GeneratorParams& params, int n,
+    int* out_w, int* out_l) {
+    std::visit([&](auto& rng) {
+        for (int i = 0; i < n; i++) {
+            std::tie(out_w[i], out_l[i]) = GenerateItemSize(rng, params);
+        }
+    }, rng_);
+}
+
 // 生成质数偏移尺寸
-int InstanceGenerator::GeneratePrimeOffsetSize(int stock_size,
+template <typename Engine>
+int InstanceGenerator::GeneratePrimeOffsetSize(Engine& rng, int stock_size,
     double min_ratio, double max_ratio) {
 
     // 选择除数 (3-7)
-    std::uniform_int_distribution<int> divisor_dist(3, 7);
-    int divisor = divisor_dist(rng_);
+    int divisor = UniformInt(rng, 3, 7);
     int base = stock_size / divisor;
 
     // 添加质数偏移
-    std::uniform_int_distribution<int> prime_idx(0, kNumPrimes - 1);
-    int prime = kPrimes[prime_idx(rng_)];
-    std::uniform_int_distribution<int> sign_dist(0, 1);
-    int sign = sign_dist(rng_) ? 1 : -1;
+    int prime = kPrimes[UniformInt(rng, 0, kNumPrimes - 1)];
+    int sign = UniformInt(rng, 0, 1) ? 1 : -1;
 
     int result = base + sign * prime;
 
@@ -554,33 +986,45 @@ int InstanceGenerator::GeneratePrimeOffsetSize(int stock_size,
 }
 
 // 生成需求量
-int InstanceGenerator::GenerateDemand(const GeneratorParams& params, bool is_peak) {
+template <InstanceGenerator::DemandSkew kSkew, typename Engine>
+int InstanceGenerator::GenerateDemand(Engine& rng, const GeneratorParams& params,
+    bool is_peak) {
     if (is_peak) {
         // 热门子板: 需求量放大2-4倍
-        std::uniform_int_distribution<int> mult_dist(2, 4);
-        int mult = mult_dist(rng_);
-        std::uniform_int_distribution<int> base_dist(params.min_demand, params.max_demand);
-        return std::min(base_dist(rng_) * mult, 50);  // 上限50
+        int mult = UniformInt(rng, 2, 4);
+        return std::min(UniformInt(rng, params.min_demand, params.max_demand) * mult,
+                        50);  // 上限50
     }
 
-    if (params.demand_skew < 0.01) {
+    if constexpr (kSkew == DemandSkew::kUniform) {
         // 均匀分布
-        std::uniform_int_distribution<int> dist(params.min_demand, params.max_demand);
-        return dist(rng_);
-    }
+        return UniformInt(rng, params.min_demand, params.max_demand);
+    } else {
+        // 偏斜分布: 更多低需求, 少量高需求
+        double r = UniformReal(rng);
 
-    // 偏斜分布: 更多低需求, 少量高需求
-    std::uniform_real_distribution<double> u(0.0, 1.0);
-    double r = u(rng_);
+        // 指数偏斜
+        double skewed = std::pow(r, 1.0 + params.demand_skew * 2.0);
+        int range = params.max_demand - params.min_demand;
+        return params.min_demand + static_cast<int>(skewed * range);
+    }
+}
 
-    // 指数偏斜
-    double skewed = std::pow(r, 1.0 + params.demand_skew * 2.0);
-    int range = params.max_demand - params.min_demand;
-    return params.min_demand + static_cast<int>(skewed * range);
+template <typename Engine>
+int InstanceGenerator::GenerateDemand(Engine& rng, const GeneratorParams& params,
+    bool is_peak) {
+    return params.demand_skew < 0.01
+        ? GenerateDemand<DemandSkew::kUniform>(rng, params, is_peak)
+        : GenerateDemand<DemandSkew::kSkewed>(rng, params, is_peak);
 }
 
 // 验证并修正算例
-bool InstanceGenerator::ValidateAndFix(Instance& inst, const GeneratorParams& params) {
+template <typename Engine>
+bool InstanceGenerator::ValidateAndFix(Engine& rng, Instance& inst,
+    const GeneratorParams& params) {
+    CS2D_TIME_SCOPE(counters_.validate_ns);
+    const size_t num_items = inst.items.size();
+
     // 移除无效子板
     auto it = std::remove_if(inst.items.begin(), inst.items.end(),
         [&inst](const Item& item) {
@@ -590,15 +1034,17 @@ bool InstanceGenerator::ValidateAndFix(Instance& inst, const GeneratorParams& pa
                    item.length > inst.stock_length;
         });
     inst.items.erase(it, inst.items.end());
+    CS2D_COUNT(counters_.fix_removed, num_items - inst.items.size());
 
     // 确保至少3种子板
     while (static_cast<int>(inst.items.size()) < 3) {
-        auto size = GenerateItemSize(params);
+        CS2D_COUNT(counters_.fix_added, 1);
+        auto size = GenerateItemSize(rng, params);
         Item item;
         item.id = static_cast<int>(inst.items.size());
         item.width = std::min(size.first, inst.stock_width);
         item.length = std::min(size.second, inst.stock_length);
-        item.demand = GenerateDemand(params, false);
+        item.demand = GenerateDemand(rng, params, false);
         inst.items.push_back(item);
     }
 
@@ -606,7 +1052,14 @@ bool InstanceGenerator::ValidateAndFix(Instance& inst, const GeneratorParams& pa
     for (int i = 0; i < static_cast<int>(inst.items.size()); i++) {
         inst.items[i].id = i;
     }
+    // 增删子板后装箱证书不再对应
+    if (inst.items.size() != num_items) {
+        inst.certificate.Clear();
+    }
 
+    // 子板列表已定型, 重新计算统计量 (预先填好缓存, 供多线程只读共享), 并记录内容指纹 (批次去重用)
+    inst.RefreshStats();
+    inst.fingerprint = ComputeFingerprint(inst);
     return inst.IsValid();
 }
 
@@ -617,34 +1070,59 @@ bool InstanceGenerator::ExportCSV(const Instance& inst, const std::string& filep
         std::filesystem::create_directories(path.parent_path());
     }
 
-    std::ofstream fout(filepath);
-    if (!fout) {
-        std::cerr << "Error: Cannot open file " << filepath << std::endl;
+    // 每线程复用格式化缓冲区
+    thread_local CsvSerializer serializer;
+    return serializer.Write(inst, filepath);
+}
+
+// 导出装箱证书
+bool InstanceGenerator::ExportCertificate(const Instance& inst, const std::string& filepath) {
+    if (inst.certificate.Empty()) return false;
+    thread_local CsvSerializer serializer;
+    const std::string& text = serializer.FormatCertificate(inst.certificate);
+    return CsvSerializer::WriteBuffer(CertificatePath(filepath), text.data(), text.size());
+}
+
+// 校验算例与证书
+bool InstanceGenerator::VerifyCertificateFile(const std::string& filepath) {
+    Instance inst;
+    if (!ImportCSV(filepath, inst)) return false;
+
+    std::string cert_path = CertificatePath(filepath);
+    CsvReader reader;
+    PackingCertificate cert;
+    if (!reader.ReadCertificate(cert_path, cert)) {
+        std::cerr << "Error: Cannot import " << cert_path << " (" << reader.Error() << ")"
+                  << std::endl;
         return false;
     }
-
-    // 文件头
-    fout << "# 2D Cutting Stock Problem Instance\n";
-    fout << "# Generated by CS-2D-Data\n";
+    std::string error;
+    if (!VerifyCertificate(inst, cert, error)) {
+        std::cerr << "Error: " << cert_path << ": " << error << std::endl;
+        return false;
+    }
+    std::cout << "证书有效: " << cert_path << " (" << cert.NumStocks() << " 块母板, "
+              << cert.NumStrips() << " 条条带)";
     if (inst.known_optimal > 0) {
-        fout << "# Known Optimal: " << inst.known_optimal << "\n";
+        if (cert.NumStocks() == inst.known_optimal) {
+            std::cout << ", 达到已知最优";
+        } else {
+            std::cout << ", 已知最优为 " << inst.known_optimal;
+        }
     }
-    fout << "#\n";
-
-    // 母板尺寸
-    fout << "stock_width,stock_length\n";
-    fout << inst.stock_width << "," << inst.stock_length << "\n";
-    fout << "#\n";
+    std::cout << std::endl;
+    return true;
+}
 
-    // 子板数据
-    fout << "id,width,length,demand\n";
-    for (const auto& item : inst.items) {
-        fout << item.id << ","
-             << item.width << ","
-             << item.length << ","
-             << item.demand << "\n";
+// 导入CSV格式
+bool InstanceGenerator::ImportCSV(const std::string& filepath, Instance& inst) {
+    // 每线程复用读取缓冲区
+    thread_local CsvReader reader;
+    if (!reader.Read(filepath, inst)) {
+        std::cerr << "Error: Cannot import " << filepath << " (" << reader.Error() << ")"
+                  << std::endl;
+        return false;
     }
-
     return true;
 }
 
@@ -674,30 +1152,198 @@ std::string InstanceGenerator::GenerateFilename(const GeneratorParams& params,
     return filename.str();
 }
 
-// 批量生成
-void InstanceGenerator::GenerateBatch(const GeneratorParams& params,
-    int count, const std::string& output_dir) {
+// 生成批量文件名
+std::string InstanceGenerator::GenerateFilename(const GeneratorParams& params,
+    const std::string& output_dir, double difficulty_score, uint64_t index) {
 
-    std::filesystem::create_directories(output_dir);
+    std::string filename = GenerateFilename(params, output_dir, difficulty_score);
 
-    for (int i = 0; i < count; i++) {
-        auto result = Generate(params);
-        if (!result.success) {
-            std::cerr << "警告: 生成第 " << i << " 个算例失败" << std::endl;
-            continue;
+    // 格式: inst_d{difficulty}_{YYYYMMDD}_{HHMMSS}_{index}.csv
+    std::ostringstream suffix;
+    suffix << "_" << std::setw(6) << std::setfill('0') << index << ".csv";
+    filename.replace(filename.size() - 4, 4, suffix.str());
+    return filename;
+}
+
+// 目标难度参数调整: 按评分偏差方向整体调整规模/尺寸/需求参数
+// 调整后的参数仍满足 Validate
+static void AdjustParamsTowardTarget(GeneratorParams& p, double score,
+                                     double target_score) {
+    bool harder = score < target_score;
+    double step = std::clamp(std::fabs(target_score - score), 0.05, 0.5);
+
+    int type_step = std::max(1, static_cast<int>(p.num_types * step * 0.5));
+    int max_types = p.large_scale ? GeneratorParams::kMaxLargeScaleTypes
+                                  : GeneratorParams::kMaxTypes;
+    p.num_types = std::clamp(p.num_types + (harder ? type_step : -type_step), 3, max_types);
+
+    double ratio_scale = harder ? 1.0 + step * 0.3 : 1.0 / (1.0 + step * 0.3);
+    p.min_size_ratio = std::clamp(p.min_size_ratio * ratio_scale, 0.01, 0.50);
+    p.max_size_ratio = std::clamp(p.max_size_ratio * ratio_scale, p.min_size_ratio, 0.80);
+
+    if (harder) {
+        p.max_demand = std::max(p.min_demand, p.max_demand - 1);
+    } else {
+        p.max_demand = p.max_demand + 1;
+    }
+}
+
+// 使用当前随机流进行目标难度生成
+GenerationResult InstanceGenerator::GenerateTargetedFromCurrentStream(
+    const GeneratorParams& params, double target_score, double tolerance,
+    int max_iterations) {
+    auto start_time = std::chrono::steady_clock::now();
+
+    GenerationResult result;
+    result.success = false;
+
+    if (!params.Validate()) {
+        result.error_message = "Invalid parameters";
+        return result;
+    }
+
+    // 外层参数调整轮次, 每轮重新生成后做逐子板局部搜索
+    const int kMaxRounds = 10;
+    int budget_per_round = std::max(1, max_iterations / kMaxRounds);
+
+    GeneratorParams round_params = params;
+    Instance best;
+    double best_dist = -1.0;
+
+    for (int round = 0; round < kMaxRounds && result.iterations < max_iterations; round++) {
+        Instance inst;
+        bool valid = std::visit([&](auto& rng) {
+            if (!GenerateWithEngine(rng, round_params, inst)) return false;
+            result.iterations++;
+            result.iterations += TuneTowardTarget(rng, inst, round_params,
+                target_score, tolerance, budget_per_round);
+            return true;
+        }, rng_);
+        if (!valid) continue;
+
+        double score = estimator_.Score(inst);
+        double dist = std::fabs(score - target_score);
+        if (best_dist < 0.0 || dist < best_dist) {
+            best = std::move(inst);
+            best_dist = dist;
         }
+        if (best_dist <= tolerance) break;
 
-        std::string filepath = GenerateFilename(params, output_dir, result.estimate.score);
-        ExportCSV(result.instance, filepath);
+        AdjustParamsTowardTarget(round_params, score, target_score);
+    }
 
-        std::cout << "已生成: " << filepath
-                  << " (难度=" << std::fixed << std::setprecision(2)
-                  << result.estimate.score << ", " << result.estimate.level_name << ")"
-                  << std::endl;
+    result.elapsed_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start_time).count();
+
+    if (best_dist < 0.0) {
+        result.error_message = "Failed to generate valid instance";
+        return result;
+    }
+
+    result.instance = std::move(best);
+    EstimateResult(result);
+    result.success = best_dist <= tolerance;
+    if (!result.success) {
+        result.error_message = "Target score not reached";
+    }
+    return result;
+}
+
+// 目标难度局部搜索
+template <typename Engine>
+int InstanceGenerator::TuneTowardTarget(Engine& rng, Instance& inst,
+    const GeneratorParams& params, double target_score, double tolerance, int budget) {
+
+    IncrementalStats inc;
+    inc.Reset(inst);
+    // 条带模式数无法增量维护: 以初始算例的模式项为定值, 变异只调整其余五项
+    const double pattern_offset = estimator_.GetPatternWeight() != 0.0
+        ? estimator_.Score(inst) - inc.Score(estimator_) : 0.0;
+    double dist = std::fabs(inc.Score(estimator_) + pattern_offset - target_score);
+    if (dist <= tolerance) return 0;
+
+    SizeSet& used_sizes = scratch_.size_set;    // 生成阶段已结束, 复用其尺寸集合
+    used_sizes.Reset(inst.stock_width, inst.stock_length, static_cast<int>(inst.items.size()));
+    for (const auto& item : inst.items) {
+        used_sizes.Insert(item.width, item.length);
+    }
 
-        // 等待1秒确保时间戳唯一
-        if (i < count - 1) {
-            std::this_thread::sleep_for(std::chrono::seconds(1));
+    const int W = inst.stock_width;
+    const int L = inst.stock_length;
+    const int n = static_cast<int>(inst.items.size());
+    const int kStallLimit = 300;
+    int stall = 0;
+    int evaluated = 0;
+    bool mutated = false;
+
+    while (evaluated < budget && stall < kStallLimit && dist > tolerance) {
+        evaluated++;
+        int idx = UniformInt(rng, 0, n - 1);
+        const Item old_item = inst.items[idx];
+        Item cand = old_item;
+
+        switch (UniformInt(rng, 0, 2)) {
+            case 0: {
+                // 需求量 ±1..2
+                int delta = UniformInt(rng, 1, 2) * (UniformInt(rng, 0, 1) ? 1 : -1);
+                cand.demand = std::clamp(cand.demand + delta, 1,
+                                         std::max(params.max_demand, 1) * 2);
+                break;
+            }
+            case 1: {
+                // 尺寸缩放 ±10%
+                double scale = UniformInt(rng, 0, 1) ? 1.1 : 1.0 / 1.1;
+                cand.width = std::clamp(static_cast<int>(cand.width * scale + 0.5), 5, W);
+                cand.length = std::clamp(static_cast<int>(cand.length * scale + 0.5), 5, L);
+                break;
+            }
+            default: {
+                // 宽度对齐到另一子板 (降低多样性) 或随机新宽度 (提高多样性)
+                if (UniformInt(rng, 0, 1)) {
+                    cand.width = inst.items[UniformInt(rng, 0, n - 1)].width;
+                } else {
+                    cand.width = UniformInt(rng, 5, std::min(W, cand.length));
+                }
+                break;
+            }
         }
+
+        // 工程规范: length >= width, 且不与已有尺寸重复
+        if (cand.length < cand.width) std::swap(cand.width, cand.length);
+        if (cand.width > W || cand.length > L) {
+            stall++;
+            continue;
+        }
+        bool same_size = cand.width == old_item.width && cand.length == old_item.length;
+        if (!same_size && used_sizes.Contains(cand.width, cand.length)) {
+            stall++;
+            continue;
+        }
+
+        inc.Modify(old_item, cand);
+        double cand_dist = std::fabs(inc.Score(estimator_) + pattern_offset - target_score);
+        if (cand_dist < dist) {
+            dist = cand_dist;
+            if (!same_size) {
+                used_sizes.Erase(old_item.width, old_item.length);
+                used_sizes.Insert(cand.width, cand.length);
+            }
+            inst.items[idx] = cand;
+            mutated = true;
+            stall = 0;
+        } else {
+            inc.Modify(cand, old_item);
+            stall++;
+        }
+    }
+
+    if (mutated) {
+        // 变异破坏了逆向生成的完美填充
+        if (inst.known_optimal > 0) CS2D_COUNT(counters_.optimal_lost, 1);
+        inst.known_optimal = -1;
+        inst.certificate.Clear();
+        inst.RefreshStats();
+        inst.fingerprint = ComputeFingerprint(inst);
     }
+    return evaluated;
 }
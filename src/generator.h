@@ -15,8 +15,20 @@
 
 #include "instance.h"
 #include "difficulty_estimator.h"
+#include "rng.h"
+#include "flat_hash.h"
+#include "width_index.h"
+#include "lower_bounds.h"
+#include "stream_format.h"
+#include "instrumentation.h"
+#include <cstdint>
+#include <cstdio>
+#include <functional>
 #include <string>
 #include <random>
+#include <utility>
+#include <variant>
+#include <vector>
 
 // 预设难度档位
 enum class Preset {
@@ -28,8 +40,12 @@ enum class Preset {
 
 // 生成参数结构体 (解耦设计, 各参数独立控制)
 struct GeneratorParams {
+    // 子板种类数上限 (常规 / 大规模模式)
+    static constexpr int kMaxTypes = 200;
+    static constexpr int kMaxLargeScaleTypes = 50000;
+
     // 规模参数
-    int num_types = 20;         // 子板种类数 (5-100)
+    int num_types = 20;         // 子板种类数 (3-200, 大规模模式至 50000)
     int stock_width = 200;      // 母板宽度 W
     int stock_length = 400;     // 母板长度 L
 
@@ -47,16 +63,28 @@ struct GeneratorParams {
     bool prime_offset = false;  // 质数偏移 (增加不可整除性)
     int num_clusters = 0;       // 尺寸聚类数 (0=不使用, 2-5=聚类生成)
     double peak_ratio = 0.0;    // 热门子板比例 (0=均匀, 0.1-0.3=部分高需求)
+    bool large_scale = false;   // 大规模模式 (放开种类数上限, 用于定价压力测试)
 
     // 生成策略
     int strategy = 1;           // 0=逆向(已知最优), 1=随机, 2=聚类, 3=残差
 
     // 随机种子
-    int seed = 0;               // 0=使用时间戳
+    int seed = 0;               // 0=使用时间戳; 批量时为基础种子, 第k个算例使用派生子流
 
     // 从预设创建参数
     static GeneratorParams FromPreset(Preset preset);
 
+    // 从单难度参数创建参数 (兼容旧接口)
+    static GeneratorParams FromLegacy(double difficulty, int stock_width = 200,
+                                      int stock_length = 400);
+
+    // 按键名设置单个参数 (键名与成员名相同, 如 "num_types" / "max_size_ratio")
+    // "preset" 以预设覆盖除母板尺寸与种子外的全部参数; 未知键或非法取值返回 false
+    bool Set(const std::string& key, const std::string& value);
+
+    // 全部参数的 (键名, 取值) 列表, 浮点数按往返精确格式输出; 逐项 Set 可还原同一参数
+    std::vector<std::pair<std::string, std::string>> ToKeyValues() const;
+
     // 参数有效性检查
     bool Validate() const;
 
@@ -68,19 +96,77 @@ struct GeneratorParams {
 struct GenerationResult {
     Instance instance;              // 生成的算例
     DifficultyEstimate estimate;    // 难度预估
+    BoundReport bounds;             // 母板数下界 (上界仅在需要时计算)
     bool success;                   // 是否成功
     std::string error_message;      // 错误信息
+
+    // 目标难度模式统计 (GenerateTargeted 填写)
+    int iterations = 0;             // 评估的变异/生成次数
+    double elapsed_ms = 0.0;        // 用时 (毫秒)
 };
 
+// 批量生成选项
+struct BatchOptions {
+    int num_jobs = 1;           // 并行工作线程数 (0=硬件线程数)
+    double target_score = -1.0; // 目标难度评分 (<0=不使用目标难度模式)
+    double target_tolerance = 0.05;  // 目标评分容差
+    int num_writers = 1;        // 写出线程数
+    int queue_depth = 0;        // 生成与写出之间的在途算例上限 (0=每个生成线程4个)
+    int write_batch = 16;       // 写出线程单次取出并同步的最大文件数
+    bool fsync = false;         // 写出后 fsync 落盘 (按批同步)
+    double min_gap_to_lb = -1.0;  // >=0 时丢弃 (上界-下界)/下界 小于该值的算例 (可证明容易)
+    std::string corpus_path;    // 非空时写入单个二进制语料文件 (见 corpus.h), 不导出 CSV
+    bool certificates = false;  // 同时导出装箱证书 (*.cert.csv, 仅逆向生成且最优已知的算例)
+    uint64_t first_index = 0;   // 批内序号起点: 生成第 first_index .. first_index+count-1 个算例
+    std::string manifest_path;  // 非空时写出虚拟语料清单 (见 virtual_corpus.h)
+    std::string fingerprint_index;  // 非空时按该指纹索引去重 (见 fingerprint.h), 新指纹追加到索引
+    int dedup_retries = 0;      // 重复算例按重抽子流重新生成的最多次数 (0 = 直接丢弃)
+    std::string stats_json_path;    // 非空时写出批次统计 JSON (阶段用时, 插桩构建下另含计数器)
+    std::string summary_path;   // 非空时流式汇总语料难度分布, 打印报告并保存 (见 corpus_summary.h)
+    bool manifest_only = false; // 只写清单, 不生成算例
+    std::FILE* stream = nullptr;    // 非空时以帧流写出 (见 stream_format.h), 不写文件
+    StreamPayload stream_payload = StreamPayload::kCsv;
+    int flush_every = 1;        // 帧流每写出多少个算例刷新一次 (0 = 只在结束时刷新)
+};
+
+class SweepSpec;
+
 // 算例生成器类
 class InstanceGenerator {
 public:
     InstanceGenerator();
-    explicit InstanceGenerator(int seed);
+    explicit InstanceGenerator(int seed, RngEngine engine = RngEngine::kXoshiro256);
+
+    // 当前随机数引擎
+    RngEngine GetEngine() const { return engine_; }
 
     // 主生成函数 (使用参数结构体)
     GenerationResult Generate(const GeneratorParams& params);
 
+    // 生成批内第index个算例 (随机流由 params.seed 和 index 派生, 可单独复现)
+    GenerationResult Generate(const GeneratorParams& params, uint64_t index);
+
+    // 写入调用方持有的结果 (复用 out.instance.items 容量, 稳态下无堆分配)
+    bool GenerateInto(const GeneratorParams& params, GenerationResult& out);
+    // attempt > 0 为去重重抽的第attempt个子流 (见 DeriveAttemptSeed)
+    bool GenerateInto(const GeneratorParams& params, uint64_t index, GenerationResult& out,
+                      uint32_t attempt = 0);
+
+    // 目标难度生成: 调整参数并逐子板变异, 直到评分落入 target±tolerance
+    GenerationResult GenerateTargeted(const GeneratorParams& params,
+                                      double target_score, double tolerance,
+                                      int max_iterations = 20000);
+
+    // 目标难度生成批内第index个算例
+    GenerationResult GenerateTargeted(const GeneratorParams& params, uint64_t index,
+                                      double target_score, double tolerance,
+                                      int max_iterations = 20000, uint32_t attempt = 0);
+
+    // 从当前随机流批量抽取 n 个随机子板尺寸 (length >= width) 写入 out_w/out_l
+    // 与逐个抽取的参考路径 GenerateItemSizesScalar 结果及随机流消耗完全一致
+    void GenerateItemSizes(const GeneratorParams& params, int n, int* out_w, int* out_l);
+    void GenerateItemSizesScalar(const GeneratorParams& params, int n, int* out_w, int* out_l);
+
     // 快捷生成 (使用预设)
     GenerationResult Generate(Preset preset);
 
@@ -88,53 +174,171 @@ public:
     GenerationResult GenerateLegacy(double difficulty, int stock_width = 200,
                                     int stock_length = 400);
 
-    // 导出为CSV格式 (2DPackLib兼容)
+    // 导出为CSV格式 (2DPackLib兼容, 自动创建父目录)
     static bool ExportCSV(const Instance& inst, const std::string& filepath);
 
+    // 导出装箱证书到 CertificatePath(filepath); 算例无证书时返回 false
+    static bool ExportCertificate(const Instance& inst, const std::string& filepath);
+
+    // 读取算例及其证书并校验, 打印结论 (成功返回 true)
+    static bool VerifyCertificateFile(const std::string& filepath);
+
+    // 计算启发式上界 (两阶段FFD, 已知最优时取已知最优) 写入 result.bounds.upper
+    int ComputeUpperBound(GenerationResult& result);
+
+    // 从CSV导入算例 (2DPackLib兼容, 解析 "# Known Optimal" 注释)
+    static bool ImportCSV(const std::string& filepath, Instance& inst);
+
+    // 目录 (含子目录) 下所有 CSV 算例文件 (不含 *.cert.csv 证书), 按路径排序
+    static std::vector<std::string> ListCSVFiles(const std::string& dir);
+
+    // 批量导入回调: (文件在排序列表中的序号, 路径, 算例), 在工作线程上并发调用
+    using ImportCallback =
+        std::function<void(size_t index, const std::string& path, const Instance& inst)>;
+
+    // 多线程导入目录下所有 CSV, 返回成功导入的数量
+    static size_t ImportDirectory(const std::string& dir, int num_jobs,
+                                  const ImportCallback& callback);
+
     // 生成文件名 (带时间戳和参数标识)
     static std::string GenerateFilename(const GeneratorParams& params,
                                         const std::string& output_dir,
                                         double difficulty_score = 0.0);
 
-    // 批量生成
+    // 生成批量文件名 (以批内序号保证唯一, 不依赖时钟秒数)
+    static std::string GenerateFilename(const GeneratorParams& params,
+                                        const std::string& output_dir,
+                                        double difficulty_score, uint64_t index);
+
+    // 批量生成 (每个工作线程持有独立的生成器和随机数引擎)
     void GenerateBatch(const GeneratorParams& params, int count,
-                       const std::string& output_dir);
+                       const std::string& output_dir,
+                       const BatchOptions& options = BatchOptions());
+
+    // 参数扫描: 展开 spec 的笛卡尔积, 以工作窃取池调度, 每个单元写入 output_dir/cell_XXXXXX/,
+    // 并在 output_dir/manifest.csv 记录每个算例的参数、种子、评分与生成用时
+    // 规格未指定种子的单元使用 default_seed (0 则随机抽取); 清单写出失败时返回 false
+    bool GenerateSweep(const SweepSpec& spec, const std::string& output_dir, int default_seed,
+                       const BatchOptions& options = BatchOptions());
+
+    // 以当前预估器重新评分目录下的所有算例 (按路径顺序输出 path,score,level)
+    // options.corpus_path 非空时同时转换为二进制语料
+    void RescoreDirectory(const std::string& dir, const BatchOptions& options = BatchOptions());
 
     // 获取难度预估器 (用于校准)
     DifficultyEstimator& GetEstimator() { return estimator_; }
     const DifficultyEstimator& GetEstimator() const { return estimator_; }
 
+    // 热路径计数器 (仅 CS2D_DATA_INSTRUMENT 构建下累计, 否则恒为 0); GenerateBatch 后为该批次之和
+    const GenerationCounters& GetCounters() const { return counters_; }
+    void ResetCounters() { counters_ = GenerationCounters(); }
+
 private:
-    std::mt19937 rng_;              // 随机数生成器
+    RngEngine engine_;              // 引擎类型
+    std::variant<Xoshiro256StarStar, std::mt19937> rng_;  // 随机数生成器
     DifficultyEstimator estimator_; // 难度预估器
 
+    // 每个生成器 (即每个工作线程) 独占的临时容器, 跨算例复用容量
+    struct Scratch {
+        std::vector<std::pair<int, int>> base_sizes;    // 逆向生成基础尺寸
+        std::vector<int> size_w, size_l;                // 批量尺寸抽样结果 (SoA)
+        std::vector<uint64_t> size_bits;                // 批量尺寸抽样的随机字块
+        std::vector<std::pair<int, int>> centers;       // 聚类中心
+        std::vector<int> type_demand;                   // 逆向生成需求表
+        std::vector<std::pair<std::pair<int, int>, int>> sized_demand;
+        WidthIndex width_index;                         // 逆向生成宽度索引
+        SizeSet size_set;                               // 尺寸去重集合
+    };
+    Scratch scratch_;
+    BoundCalculator bounds_;        // 界计算临时容器
+    GenerationCounters counters_;   // 热路径计数器
+
     // 设置随机种子
     void SetSeed(int seed);
 
+    // 设置64位派生子流种子
+    void SetStreamSeed(uint64_t stream_seed);
+
+    // 从当前随机流抽取一个31位正整数 (用于派生批次种子)
+    int DrawSeed();
+
+    // 使用当前随机流生成算例
+    bool GenerateFromCurrentStream(const GeneratorParams& params, GenerationResult& out);
+
+    // 预估难度并计算下界, 以最强下界修正利用率下界
+    void EstimateResult(GenerationResult& result);
+
+    // 使用当前随机流进行目标难度生成
+    GenerationResult GenerateTargetedFromCurrentStream(const GeneratorParams& params,
+                                                       double target_score,
+                                                       double tolerance,
+                                                       int max_iterations);
+
+    // 以下策略与采样函数以引擎类型为模板参数, 每次生成只分派一次引擎
+    // (仅在 generator.cpp 内实例化); 策略函数原地重写 inst, 保留其容量.
+    // 质数偏移与需求偏斜同样作为编译期选项, 由 GenerateWithEngine 按参数分派一次到特化的
+    // 生成核, 内层循环不再逐子板检查这些标志 (运行时版本仅供补足子板等零星调用)
+    enum class PrimeOffset { kOff, kOn };
+    enum class DemandSkew { kUniform, kSkewed };     // demand_skew < 0.01 视为均匀
+
+    // 按 (策略, 质数偏移, 需求偏斜) 分派到特化生成核
+    template <typename Engine>
+    void GenerateDispatch(Engine& rng, const GeneratorParams& params, Instance& inst);
+
+    template <PrimeOffset kPrime, DemandSkew kSkew, typename Engine>
+    void GenerateKernel(Engine& rng, const GeneratorParams& params, Instance& inst);
+
     // 策略0: 逆向生成 (构造完美填充, 已知最优解)
-    Instance GenerateReverse(const GeneratorParams& params);
+    template <PrimeOffset kPrime, typename Engine>
+    void GenerateReverse(Engine& rng, const GeneratorParams& params, Instance& inst);
 
     // 策略1: 参数化随机生成
-    Instance GenerateRandom(const GeneratorParams& params);
+    template <PrimeOffset kPrime, DemandSkew kSkew, typename Engine>
+    void GenerateRandom(Engine& rng, const GeneratorParams& params, Instance& inst);
 
     // 策略2: 聚类生成 (尺寸分群)
-    Instance GenerateCluster(const GeneratorParams& params);
+    template <PrimeOffset kPrime, DemandSkew kSkew, typename Engine>
+    void GenerateCluster(Engine& rng, const GeneratorParams& params, Instance& inst);
 
-    // 策略3: 残差生成 (难以完美填充)
-    Instance GenerateResidual(const GeneratorParams& params);
+    // 策略3: 残差生成 (难以完美填充; 尺寸总使用质数偏移, 与 prime_offset 无关)
+    template <DemandSkew kSkew, typename Engine>
+    void GenerateResidual(Engine& rng, const GeneratorParams& params, Instance& inst);
 
     // 生成单个子板尺寸
-    std::pair<int, int> GenerateItemSize(const GeneratorParams& params,
+    template <PrimeOffset kPrime, typename Engine>
+    std::pair<int, int> GenerateItemSize(Engine& rng, const GeneratorParams& params,
                                          int base_w = 0, int base_l = 0);
+    template <typename Engine>
+    std::pair<int, int> GenerateItemSize(Engine& rng, const GeneratorParams& params);
+
+    // 批量生成 n 个子板尺寸 (结果与逐个调用 GenerateItemSize 相同)
+    template <PrimeOffset kPrime, typename Engine>
+    void GenerateItemSizes(Engine& rng, const GeneratorParams& params, int n,
+                           int* out_w, int* out_l);
 
     // 生成"不友好"的尺寸 (质数偏移)
-    int GeneratePrimeOffsetSize(int stock_size, double min_ratio, double max_ratio);
+    template <typename Engine>
+    int GeneratePrimeOffsetSize(Engine& rng, int stock_size,
+                                double min_ratio, double max_ratio);
 
     // 生成需求量 (支持偏斜分布)
-    int GenerateDemand(const GeneratorParams& params, bool is_peak = false);
+    template <DemandSkew kSkew, typename Engine>
+    int GenerateDemand(Engine& rng, const GeneratorParams& params, bool is_peak);
+    template <typename Engine>
+    int GenerateDemand(Engine& rng, const GeneratorParams& params, bool is_peak = false);
+
+    // 按策略生成并验证修正
+    template <typename Engine>
+    bool GenerateWithEngine(Engine& rng, const GeneratorParams& params, Instance& inst);
 
     // 验证并修正算例
-    bool ValidateAndFix(Instance& inst, const GeneratorParams& params);
+    template <typename Engine>
+    bool ValidateAndFix(Engine& rng, Instance& inst, const GeneratorParams& params);
+
+    // 目标难度局部搜索: 逐子板变异, 增量评分, 贪心接受; 返回评估次数
+    template <typename Engine>
+    int TuneTowardTarget(Engine& rng, Instance& inst, const GeneratorParams& params,
+                         double target_score, double tolerance, int budget);
 };
 
 #endif  // CS_2D_DATA_GENERATOR_H_
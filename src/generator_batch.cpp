@@ -0,0 +1,678 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// generator_batch.cpp - 批量生成实现
+// 流水线: 生成线程 (生成 -> 预估) --有界队列--> 写出线程 (按批写文件/同步)
+// 结果槽位预先分配并在两条无锁队列间循环, 空闲槽位耗尽即对生成端形成背压
+
+#include "generator.h"
+#include "bounded_queue.h"
+#include "corpus_summary.h"
+#include "corpus_writer.h"
+#include "csv_io.h"
+#include "fingerprint.h"
+#include "virtual_corpus.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double SecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// 流水线中的一个在途算例
+struct BatchSlot {
+    uint64_t index = 0;         // 批次内序号 (first_index + i, 可超出 int 范围)
+    GenerationResult result;    // 跨算例复用, 稳态下无堆分配
+};
+
+// 单个阶段的累计耗时 (所有线程之和)
+struct StageTimer {
+    std::atomic<long long> busy_ns{0};
+    std::atomic<long long> wait_ns{0};
+
+    static long long Ns(Clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now() - start).count();
+    }
+};
+
+// 打印阶段吞吐: 处理数 / (忙碌时间 / 线程数)
+void PrintStage(const char* name, int processed, int threads, const StageTimer& timer) {
+    double busy = timer.busy_ns.load() * 1e-9;
+    double wait = timer.wait_ns.load() * 1e-9;
+    std::cout << "  " << name << ": " << threads << " 线程, 忙碌 "
+              << std::setprecision(2) << busy << " 秒, 等待 " << wait << " 秒";
+    if (busy > 0.0) {
+        std::cout << ", 阶段吞吐 " << std::setprecision(1)
+                  << processed * threads / busy << " 个/秒";
+    }
+    std::cout << std::endl;
+}
+
+void AppendStageJson(std::string& json, const char* name, int processed, int threads,
+                     const StageTimer& timer, bool last) {
+    char line[192];
+    std::snprintf(line, sizeof(line),
+                  "    \"%s\": {\"threads\": %d, \"processed\": %d, \"busy_s\": %.6f, "
+                  "\"wait_s\": %.6f}%s\n",
+                  name, threads, processed, timer.busy_ns.load() * 1e-9,
+                  timer.wait_ns.load() * 1e-9, last ? "" : ",");
+    json += line;
+}
+
+}  // namespace
+
+// 批量生成
+void InstanceGenerator::GenerateBatch(const GeneratorParams& params,
+    int count, const std::string& output_dir, const BatchOptions& options) {
+
+    // 二进制语料模式: 所有算例写入同一文件, 不再逐个导出 CSV
+    const bool to_corpus = !options.corpus_path.empty();
+    const bool to_stream = options.stream != nullptr;
+    if (to_corpus) {
+        std::filesystem::path corpus_path(options.corpus_path);
+        if (corpus_path.has_parent_path()) {
+            std::filesystem::create_directories(corpus_path.parent_path());
+        }
+    } else if (!options.manifest_only && !to_stream) {
+        std::filesystem::create_directories(output_dir);
+    }
+
+    // 确定线程数
+    int num_jobs = options.num_jobs;
+    if (num_jobs <= 0) {
+        num_jobs = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    num_jobs = std::clamp(num_jobs, 1, std::max(1, count));
+    int num_writers = std::clamp(options.num_writers, 1, std::max(1, count));
+    int write_batch = std::max(1, options.write_batch);
+
+    // 在途槽位数 = 队列深度; 两条队列容量均不小于槽位数, 入队永不失败
+    int num_slots = options.queue_depth > 0 ? options.queue_depth : num_jobs * 4;
+    num_slots = std::max(num_slots, num_jobs);
+
+    // 确定批次基础种子 (0 则随机抽取并打印, 以便复现)
+    GeneratorParams batch_params = params;
+    if (batch_params.seed == 0) {
+        batch_params.seed = DrawSeed();
+    }
+    std::cout << "批次种子: " << batch_params.seed
+              << " (第k个算例可用 -s " << batch_params.seed
+              << " --index k 单独复现)" << std::endl;
+
+    // 虚拟语料清单: 记录批次设置, 任意子集可由 --materialize 重新生成
+    if (!options.manifest_path.empty()) {
+        VirtualCorpus manifest = VirtualCorpus::FromBatch(
+            batch_params, engine_, options.first_index + static_cast<uint64_t>(count),
+            options, estimator_);
+        if (!manifest.Save(options.manifest_path)) return;
+        std::cout << "虚拟语料清单: " << options.manifest_path << std::endl;
+        if (options.manifest_only) return;
+    }
+
+    // 目标难度模式
+    bool targeted = options.target_score >= 0.0;
+    if (targeted) {
+        std::cout << "目标难度: " << options.target_score
+                  << " ± " << options.target_tolerance << std::endl;
+    }
+
+    CorpusWriter corpus;
+    if (to_corpus && !corpus.Open(options.corpus_path, static_cast<uint64_t>(count),
+                                  static_cast<uint64_t>(batch_params.seed))) {
+        return;
+    }
+
+    // 帧流模式: 算例按完成顺序写为帧, 每 flush_every 个刷新一次, 下游可边生成边消费
+    FrameWriter frames(options.stream, options.flush_every);
+    if (to_stream && !frames.WriteHeader()) {
+        std::cerr << "Error: Failed to write output stream" << std::endl;
+        return;
+    }
+
+    // 指纹去重: 载入已有索引, 与其中 (或本批次序号更小的) 算例内容相同者重抽或丢弃
+    const bool dedup = !options.fingerprint_index.empty();
+    const uint32_t dedup_retries = static_cast<uint32_t>(std::max(0, options.dedup_retries));
+    FingerprintIndex fingerprints;
+    if (dedup) {
+        if (!fingerprints.Open(options.fingerprint_index, static_cast<uint64_t>(count))) return;
+        std::cout << "指纹索引: " << options.fingerprint_index << " ("
+                  << fingerprints.NumLoaded() << " 个已有指纹)" << std::endl;
+    }
+
+    std::vector<BatchSlot> slots(num_slots);
+    BoundedQueue<int> free_slots(num_slots);
+    BoundedQueue<int> ready_slots(num_slots);
+    for (int s = 0; s < num_slots; s++) {
+        free_slots.TryPush(s);
+    }
+
+    // 本生成器的计数器改为记录本批次 (各线程之和)
+    ResetCounters();
+
+    // 语料汇总: 各生成线程独立累加, 结束时合并
+    const bool summarize = !options.summary_path.empty();
+    CorpusSummary batch_summary;
+
+    std::atomic<int> next_index(0);
+    // 去重按序号依次查重: 第i个算例等到 dedup_turn == i 才查重 (生成仍并行), 重抽期间持有轮次,
+    // 保留哪一个、哪个序号重抽只取决于序号, 与线程数和调度无关
+    std::atomic<int> dedup_turn(0);
+    std::atomic<int> active_generators(num_jobs);
+    std::atomic<int> num_failed(0);
+    std::atomic<int> num_write_failed(0);
+    std::atomic<int> num_generated(0);
+    std::atomic<int> num_filtered(0);
+    std::atomic<int> num_duplicates(0);
+    std::atomic<int> num_dropped(0);
+    std::atomic<int> num_written(0);
+    std::atomic<long long> total_iterations(0);
+    StageTimer gen_timer;
+    StageTimer write_timer;
+    std::mutex output_mutex;
+
+    auto start_time = Clock::now();
+
+    // 帧流模式下未写出的算例 (生成失败/被筛除/重复丢弃) 各写一个 FAIL 帧, 与 --serve 一致
+    auto report_failure = [&](uint64_t index, const std::string& reason) {
+        if (to_stream && !frames.WriteFailure(index, reason)) {
+            num_write_failed.fetch_add(1);
+            next_index.store(count);    // 下游已关闭, 不再生成
+        }
+    };
+
+    auto generator_main = [&](int worker_id) {
+        // 独立的生成器与随机数引擎, 共享当前校准权重
+        // 每个算例的随机流由 (批次种子, 序号) 派生, 输出与调度顺序无关
+        InstanceGenerator worker(worker_id + 1, engine_);
+        worker.estimator_ = estimator_;
+        CorpusSummary summary;
+
+        for (int i = next_index.fetch_add(1); i < count; i = next_index.fetch_add(1)) {
+            // 获取空闲槽位; 写出跟不上时在此阻塞 (背压)
+            int s;
+            auto wait_start = Clock::now();
+            Backoff backoff;
+            while (!free_slots.TryPop(s)) {
+                backoff.Wait();
+            }
+            gen_timer.wait_ns.fetch_add(StageTimer::Ns(wait_start));
+
+            BatchSlot& slot = slots[s];
+            const uint64_t index = options.first_index + static_cast<uint64_t>(i);
+            slot.index = index;
+
+            // 等待去重轮次 (每个序号只等一次, 查重前或放弃该序号时)
+            bool has_turn = false;
+            auto await_turn = [&]() {
+                if (has_turn) return;
+                auto turn_start = Clock::now();
+                Backoff turn_backoff;
+                while (dedup_turn.load(std::memory_order_acquire) != i) {
+                    turn_backoff.Wait();
+                }
+                gen_timer.wait_ns.fetch_add(StageTimer::Ns(turn_start));
+                has_turn = true;
+            };
+
+            // 重复算例按 (序号, attempt) 派生的新子流重新生成, 直至不重复或重抽次数用尽
+            bool ready = false;
+            for (uint32_t attempt = 0;; attempt++) {
+                auto busy_start = Clock::now();
+                if (targeted) {
+                    slot.result = worker.GenerateTargeted(batch_params, index,
+                        options.target_score, options.target_tolerance, 20000, attempt);
+                    total_iterations.fetch_add(slot.result.iterations);
+                } else {
+                    worker.GenerateInto(batch_params, index, slot.result, attempt);
+                }
+                gen_timer.busy_ns.fetch_add(StageTimer::Ns(busy_start));
+
+                if (!slot.result.success) {
+                    num_failed.fetch_add(1);
+                    report_failure(index, slot.result.error_message);
+                    std::lock_guard<std::mutex> lock(output_mutex);
+                    std::cerr << "警告: 生成第 " << index << " 个算例失败 ("
+                              << slot.result.error_message << ")" << std::endl;
+                    break;
+                }
+                num_generated.fetch_add(1);
+
+                // 下界筛选: 启发式上界已接近下界的算例可在根节点求解, 不写出
+                if (options.min_gap_to_lb >= 0.0) {
+                    worker.ComputeUpperBound(slot.result);
+                    double gap = slot.result.bounds.GapToLowerBound();
+                    if (gap >= 0.0 && gap < options.min_gap_to_lb) {
+                        num_filtered.fetch_add(1);
+                        report_failure(index, "Filtered by min_gap_to_lb");
+                        break;
+                    }
+                }
+
+                if (!dedup) {
+                    ready = true;
+                    break;
+                }
+                await_turn();
+                if (fingerprints.Insert(slot.result.instance.fingerprint)) {
+                    ready = true;
+                    break;
+                }
+                num_duplicates.fetch_add(1);
+                if (attempt >= dedup_retries) {
+                    num_dropped.fetch_add(1);
+                    report_failure(index, "Duplicate fingerprint");
+                    break;
+                }
+            }
+            if (dedup) {
+                // 失败或被筛除的序号也要依次让出轮次
+                await_turn();
+                dedup_turn.store(i + 1, std::memory_order_release);
+            }
+            if (ready) {
+                if (summarize) summary.Add(slot.result);
+                ready_slots.TryPush(s);
+            } else {
+                free_slots.TryPush(s);
+            }
+        }
+        // 计数器并入本生成器, 批次结束后可由 GetCounters 读取
+        if (GenerationCounters::kEnabled || summarize) {
+            std::lock_guard<std::mutex> lock(output_mutex);
+            counters_.Merge(worker.counters_);
+            batch_summary.Merge(summary);
+        }
+        active_generators.fetch_sub(1, std::memory_order_release);
+    };
+
+    auto writer_main = [&]() {
+        CsvSerializer serializer;
+        GenerationCounters writer_counters;
+        std::vector<int> batch;
+        std::vector<std::FILE*> pending;
+        batch.reserve(write_batch);
+        pending.reserve(write_batch);
+
+        for (;;) {
+            // 取出一批就绪算例; 队列为空且生成端全部结束时退出
+            auto wait_start = Clock::now();
+            Backoff backoff;
+            int s;
+            batch.clear();
+            while (batch.empty()) {
+                while (static_cast<int>(batch.size()) < write_batch && ready_slots.TryPop(s)) {
+                    batch.push_back(s);
+                }
+                if (!batch.empty()) break;
+                if (active_generators.load(std::memory_order_acquire) == 0) {
+                    // 生成端结束后再检查一次, 避免遗漏最后入队的槽位
+                    if (!ready_slots.TryPop(s)) break;
+                    batch.push_back(s);
+                    break;
+                }
+                backoff.Wait();
+            }
+            write_timer.wait_ns.fetch_add(StageTimer::Ns(wait_start));
+            if (batch.empty()) break;
+
+            // 写出整批文件, 需要落盘时整批写完后再统一同步
+            auto busy_start = Clock::now();
+            pending.clear();
+            for (int b : batch) {
+                BatchSlot& slot = slots[b];
+                CS2D_TIME_SCOPE(writer_counters.export_ns);
+                if (to_stream) {
+                    // 不逐个打印, 以免大批次时 stderr 输出淹没进度
+                    if (frames.WriteInstance(options.stream_payload, slot.index,
+                                             slot.result.instance, slot.result.estimate.score)) {
+                        num_written.fetch_add(1);
+                    } else {
+                        num_write_failed.fetch_add(1);
+                        next_index.store(count);    // 下游已关闭, 不再生成
+                    }
+                    continue;
+                }
+                if (to_corpus) {
+                    // 语料偏移表按本次生成的区间内序号索引
+                    if (!corpus.Append(slot.index - options.first_index,
+                                       slot.result.instance,
+                                       slot.result.estimate.score)) {
+                        num_write_failed.fetch_add(1);
+                        continue;
+                    }
+                    num_written.fetch_add(1);
+                    std::lock_guard<std::mutex> lock(output_mutex);
+                    std::cout << "已生成: " << options.corpus_path << "#" << slot.index
+                              << " (难度=" << std::fixed << std::setprecision(2)
+                              << slot.result.estimate.score << ", "
+                              << slot.result.estimate.level_name << ")" << std::endl;
+                    continue;
+                }
+                std::string filepath = GenerateFilename(batch_params, output_dir,
+                                                        slot.result.estimate.score, slot.index);
+                // 输出目录已在批次开始时创建
+                bool ok;
+                if (options.fsync) {
+                    std::FILE* file = serializer.WriteOpen(slot.result.instance, filepath);
+                    ok = file != nullptr;
+                    if (ok) pending.push_back(file);
+                } else {
+                    ok = serializer.Write(slot.result.instance, filepath);
+                }
+                // 证书与算例同批写出; 证书写失败计为该算例写出失败
+                const PackingCertificate& cert = slot.result.instance.certificate;
+                if (ok && options.certificates && !cert.Empty()) {
+                    const std::string& text = serializer.FormatCertificate(cert);
+                    std::string cert_path = CertificatePath(filepath);
+                    if (options.fsync) {
+                        std::FILE* file = CsvSerializer::WriteBufferOpen(cert_path, text.data(),
+                                                                         text.size());
+                        ok = file != nullptr;
+                        if (ok) pending.push_back(file);
+                    } else {
+                        ok = CsvSerializer::WriteBuffer(cert_path, text.data(), text.size());
+                    }
+                }
+                if (!ok) {
+                    num_write_failed.fetch_add(1);
+                } else {
+                    num_written.fetch_add(1);
+                    std::lock_guard<std::mutex> lock(output_mutex);
+                    std::cout << "已生成: " << filepath
+                              << " (难度=" << std::fixed << std::setprecision(2)
+                              << slot.result.estimate.score << ", "
+                              << slot.result.estimate.level_name << ")" << std::endl;
+                }
+            }
+            for (std::FILE* file : pending) {
+                if (!CsvSerializer::SyncAndClose(file)) {
+                    num_write_failed.fetch_add(1);
+                    num_written.fetch_sub(1);
+                }
+            }
+            write_timer.busy_ns.fetch_add(StageTimer::Ns(busy_start));
+
+            for (int b : batch) {
+                free_slots.TryPush(b);
+            }
+        }
+        if (GenerationCounters::kEnabled) {
+            std::lock_guard<std::mutex> lock(output_mutex);
+            counters_.Merge(writer_counters);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_jobs + num_writers);
+    for (int w = 0; w < num_jobs; w++) {
+        threads.emplace_back(generator_main, w);
+    }
+    for (int w = 0; w < num_writers; w++) {
+        threads.emplace_back(writer_main);
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    if (to_corpus && !corpus.Finish(options.fsync)) {
+        num_write_failed.fetch_add(1);
+    }
+    if (dedup && !fingerprints.Save()) {
+        num_write_failed.fetch_add(1);
+    }
+
+    double elapsed = SecondsSince(start_time);
+    int num_ok = num_written.load();
+    if (to_stream) {
+        std::string summary = "seed=" + std::to_string(batch_params.seed) +
+                              " count=" + std::to_string(count) +
+                              " delivered=" + std::to_string(num_ok) +
+                              " failed=" + std::to_string(num_failed.load()) +
+                              " filtered=" + std::to_string(num_filtered.load()) +
+                              " dropped=" + std::to_string(num_dropped.load());
+        if (!frames.WriteEnd(static_cast<uint64_t>(num_ok), summary)) {
+            std::cerr << "Error: Failed to write output stream" << std::endl;
+        }
+    }
+    std::cout << "\n批量完成: " << num_ok << "/" << count << " 个算例, "
+              << num_jobs << " 生成线程 + " << num_writers << " 写出线程, 用时 "
+              << std::fixed << std::setprecision(2) << elapsed << " 秒";
+    if (elapsed > 0.0) {
+        std::cout << " (" << std::setprecision(1) << num_ok / elapsed << " 个/秒)";
+    }
+    std::cout << std::endl;
+    PrintStage("生成阶段", num_generated.load(), num_jobs, gen_timer);
+    PrintStage("写出阶段", num_ok, num_writers, write_timer);
+    if (num_filtered.load() > 0) {
+        std::cout << "  已过滤 (上界-下界间隙 < " << std::defaultfloat
+                  << options.min_gap_to_lb << "): " << num_filtered.load() << " 个"
+                  << std::fixed << std::endl;
+    }
+    if (dedup) {
+        std::cout << "  重复算例: " << num_duplicates.load() << " 次 (重抽上限 "
+                  << dedup_retries << ", 丢弃 " << num_dropped.load() << " 个)" << std::endl;
+    }
+    if (num_write_failed.load() > 0) {
+        std::cout << "  写出失败: " << num_write_failed.load() << " 个" << std::endl;
+    }
+    if (targeted && count > 0) {
+        std::cout << "平均迭代次数: " << std::setprecision(1)
+                  << static_cast<double>(total_iterations.load()) / count << std::endl;
+    }
+
+    if (summarize) {
+        batch_summary.Print(std::cout);
+        if (batch_summary.Save(options.summary_path)) {
+            std::cout << "语料汇总: " << options.summary_path << std::endl;
+        }
+    }
+
+    // 批次统计 JSON: 计数与阶段用时; 插桩构建下另含热路径计数器 (本批次各线程之和)
+    if (!options.stats_json_path.empty()) {
+        char head[640];
+        std::snprintf(head, sizeof(head),
+                      "{\n  \"seed\": %d,\n  \"count\": %d,\n  \"first_index\": %llu,\n"
+                      "  \"strategy\": %d,\n  \"num_types\": %d,\n  \"written\": %d,\n"
+                      "  \"failed\": %d,\n  \"filtered\": %d,\n  \"duplicates\": %d,\n"
+                      "  \"dropped_duplicates\": %d,\n  \"write_failed\": %d,\n"
+                      "  \"elapsed_s\": %.6f,\n  \"stages\": {\n",
+                      batch_params.seed, count,
+                      static_cast<unsigned long long>(options.first_index),
+                      batch_params.strategy, batch_params.num_types, num_ok, num_failed.load(),
+                      num_filtered.load(), num_duplicates.load(), num_dropped.load(),
+                      num_write_failed.load(), elapsed);
+        std::string json = head;
+        AppendStageJson(json, "generate", num_generated.load(), num_jobs, gen_timer, false);
+        AppendStageJson(json, "write", num_ok, num_writers, write_timer, true);
+        json += "  },\n";
+        json += std::string("  \"instrumented\": ") +
+                (GenerationCounters::kEnabled ? "true" : "false");
+        if (GenerationCounters::kEnabled) {
+            json += ",\n  \"counters\": " + counters_.ToJson(4);
+        }
+        json += "\n}\n";
+
+        std::ofstream file(options.stats_json_path);
+        if (!file.is_open() || !(file << json)) {
+            std::cerr << "Error: Cannot write " << options.stats_json_path << std::endl;
+        } else {
+            std::cout << "批次统计: " << options.stats_json_path << std::endl;
+        }
+    }
+}
+
+// 目录 (含子目录) 下所有 CSV 文件
+std::vector<std::string> InstanceGenerator::ListCSVFiles(const std::string& dir) {
+    std::vector<std::string> files;
+    std::error_code ec;
+    for (std::filesystem::recursive_directory_iterator it(dir, ec), end; !ec && it != end;
+         it.increment(ec)) {
+        if (it->is_regular_file(ec) && it->path().extension() == ".csv" &&
+            it->path().stem().extension() != ".cert") {
+            files.push_back(it->path().string());
+        }
+    }
+    if (ec) {
+        std::cerr << "Error: Cannot read directory " << dir << " (" << ec.message() << ")"
+                  << std::endl;
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+// 多线程批量导入
+size_t InstanceGenerator::ImportDirectory(const std::string& dir, int num_jobs,
+                                          const ImportCallback& callback) {
+    std::vector<std::string> files = ListCSVFiles(dir);
+    if (num_jobs <= 0) {
+        num_jobs = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    num_jobs = std::clamp(num_jobs, 1, std::max(1, static_cast<int>(files.size())));
+
+    std::atomic<size_t> next_index(0);
+    std::atomic<size_t> num_imported(0);
+    auto worker_main = [&]() {
+        // 每个线程复用缓冲区与算例容器
+        CsvReader reader;
+        Instance inst;
+        for (size_t i = next_index.fetch_add(1); i < files.size(); i = next_index.fetch_add(1)) {
+            if (!reader.Read(files[i], inst)) {
+                std::cerr << "Error: Cannot import " << files[i] << " (" << reader.Error()
+                          << ")" << std::endl;
+                continue;
+            }
+            callback(i, files[i], inst);
+            num_imported.fetch_add(1);
+        }
+    };
+
+    if (num_jobs == 1) {
+        worker_main();
+    } else {
+        std::vector<std::thread> threads;
+        threads.reserve(num_jobs);
+        for (int w = 0; w < num_jobs; w++) {
+            threads.emplace_back(worker_main);
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+    return num_imported.load();
+}
+
+// 重新评分目录
+void InstanceGenerator::RescoreDirectory(const std::string& dir, const BatchOptions& options) {
+    auto start_time = Clock::now();
+
+    // 先列出文件以确定语料偏移表大小; ImportDirectory 内部按相同顺序编号
+    const size_t num_files = ListCSVFiles(dir).size();
+    const bool to_corpus = !options.corpus_path.empty();
+    CorpusWriter corpus;
+    if (to_corpus) {
+        std::filesystem::path corpus_path(options.corpus_path);
+        if (corpus_path.has_parent_path()) {
+            std::filesystem::create_directories(corpus_path.parent_path());
+        }
+        if (!corpus.Open(options.corpus_path, num_files, 0)) return;
+    }
+
+    // 导入阶段只保存统计量, 全部导入后一次批量评分, 再按路径顺序输出
+    std::vector<std::string> paths(num_files);
+    std::vector<InstanceStats> stats(num_files);
+    std::vector<char> imported(num_files, 0);
+    std::atomic<int> num_write_failed(0);
+
+    // 语料汇总的利用率下界与生成时一致, 以组合下界计算 (导入线程各用一个界计算器)
+    const bool summarize = !options.summary_path.empty();
+    std::vector<double> utilization(summarize ? num_files : 0, 0.0);
+
+    size_t num_ok = ImportDirectory(dir, options.num_jobs,
+        [&](size_t index, const std::string& path, const Instance& inst) {
+            if (index >= num_files) return;     // 目录在两次列举之间发生变化
+            paths[index] = path;
+            stats[index] = inst.Stats();
+            // Stats() 不含条带模式数, 补上后评分与生成时的 Estimate(inst) 一致
+            stats[index].strip_patterns = DifficultyEstimator::CountStripPatterns(inst);
+            imported[index] = 1;
+            if (summarize) {
+                thread_local BoundCalculator bounds;
+                utilization[index] = bounds.ComputeLower(inst).utilization_lb;
+            }
+            if (to_corpus && !corpus.Append(index, inst, estimator_.Score(stats[index]))) {
+                num_write_failed.fetch_add(1);
+            }
+        });
+    if (to_corpus && !corpus.Finish(options.fsync)) {
+        num_write_failed.fetch_add(1);
+    }
+
+    std::vector<double> scores(num_files);
+    std::vector<DifficultyLevel> levels(num_files);
+    estimator_.EstimateBatch(stats.data(), num_files, scores.data(), levels.data());
+
+    constexpr int kNumLevels = static_cast<int>(DifficultyLevel::kExpert) + 1;
+    int level_counts[kNumLevels] = {};
+    double score_sum = 0.0;
+    CorpusSummary summary;
+    std::cout << "file,score,level\n";
+    for (size_t i = 0; i < num_files; i++) {
+        if (!imported[i]) continue;
+        std::cout << paths[i] << "," << std::fixed << std::setprecision(4) << scores[i]
+                  << "," << DifficultyEstimator::LevelName(levels[i]) << "\n";
+        score_sum += scores[i];
+        level_counts[static_cast<int>(levels[i])]++;
+        if (summarize) {
+            summary.Add(stats[i], scores[i], levels[i], utilization[i]);
+        }
+    }
+
+    double elapsed = SecondsSince(start_time);
+    std::cout << "\n重新评分: " << num_ok << "/" << num_files << " 个算例, 用时 "
+              << std::setprecision(2) << elapsed << " 秒";
+    if (elapsed > 0.0) {
+        std::cout << " (" << std::setprecision(1) << num_ok / elapsed << " 个/秒)";
+    }
+    std::cout << std::endl;
+    if (num_ok > 0) {
+        std::cout << "平均评分: " << std::setprecision(4) << score_sum / num_ok << "\n";
+        for (int level = 0; level < kNumLevels; level++) {
+            if (level_counts[level] == 0) continue;
+            std::cout << "  " << DifficultyEstimator::LevelName(static_cast<DifficultyLevel>(level))
+                      << ": " << level_counts[level] << "\n";
+        }
+    }
+    if (to_corpus) {
+        std::cout << "已写入语料: " << options.corpus_path << " ("
+                  << corpus.NumWritten() << " 个算例)" << std::endl;
+    }
+    if (num_write_failed.load() > 0) {
+        std::cout << "  写出失败: " << num_write_failed.load() << " 个" << std::endl;
+    }
+    if (summarize) {
+        summary.Print(std::cout);
+        if (summary.Save(options.summary_path)) {
+            std::cout << "语料汇总: " << options.summary_path << std::endl;
+        }
+    }
+}
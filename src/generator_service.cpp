@@ -0,0 +1,202 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// generator_service.cpp - 常驻生成服务实现
+
+#include "generator_service.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+namespace {
+
+bool ParseCount(const std::string& s, uint64_t& value) {
+    if (s.empty() || s[0] == '-') return false;
+    char* end = nullptr;
+    value = std::strtoull(s.c_str(), &end, 10);
+    return *end == '\0';
+}
+
+bool ParseReal(const std::string& s, double& value) {
+    if (s.empty()) return false;
+    char* end = nullptr;
+    value = std::strtod(s.c_str(), &end);
+    return *end == '\0';
+}
+
+}  // namespace
+
+bool ServiceRequest::Parse(const std::string& line, ServiceRequest& out, std::string& error) {
+    out = ServiceRequest();
+    // 先取出 id, 解析失败时 ERR 帧也能带上
+    {
+        std::istringstream scan(line);
+        std::string token;
+        while (scan >> token) {
+            if (token.compare(0, 3, "id=") == 0) out.id = token.substr(3);
+        }
+    }
+    std::istringstream tokens(line);
+    std::vector<std::pair<std::string, std::string>> param_values;
+    std::string token;
+    while (tokens >> token) {
+        size_t eq = token.find('=');
+        if (eq == std::string::npos || eq == 0) {
+            error = "expected key=value: " + token;
+            return false;
+        }
+        std::string key = token.substr(0, eq);
+        std::string value = token.substr(eq + 1);
+
+        bool ok = true;
+        if (key == "count") {
+            ok = ParseCount(value, out.count) && out.count > 0;
+        } else if (key == "index") {
+            ok = ParseCount(value, out.first_index);
+        } else if (key == "format") {
+            if (value == "csv") out.payload = StreamPayload::kCsv;
+            else if (value == "bin") out.payload = StreamPayload::kBinary;
+            else ok = false;
+        } else if (key == "target_score") {
+            ok = ParseReal(value, out.target_score);
+        } else if (key == "tolerance") {
+            ok = ParseReal(value, out.target_tolerance);
+        } else if (key == "id") {
+            out.id = value;
+        } else {
+            GeneratorParams probe;
+            ok = probe.Set(key, value);
+            param_values.emplace_back(key, value);
+        }
+        if (!ok) {
+            error = "bad value " + key + "=" + value;
+            return false;
+        }
+    }
+
+    // "preset" 覆盖其余参数, 最先应用
+    for (const auto& kv : param_values) {
+        if (kv.first == "preset") out.params.Set(kv.first, kv.second);
+    }
+    for (const auto& kv : param_values) {
+        if (kv.first != "preset") out.params.Set(kv.first, kv.second);
+    }
+    if (out.params.seed == 0) {
+        error = "seed must be nonzero";
+        return false;
+    }
+    if (!out.params.Validate()) {
+        error = "invalid generator parameters";
+        return false;
+    }
+    return true;
+}
+
+GeneratorService::GeneratorService(int num_workers, RngEngine engine,
+                                   const DifficultyEstimator& estimator) {
+    if (num_workers <= 0) {
+        num_workers = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    num_workers = std::max(num_workers, 1);
+    workers_.reserve(num_workers);
+    for (int w = 0; w < num_workers; w++) {
+        workers_.emplace_back(w + 1, engine);
+        workers_.back().GetEstimator() = estimator;
+    }
+    results_.resize(num_workers);
+}
+
+bool GeneratorService::Run(std::istream& in, FrameWriter& writer) {
+    if (!writer.WriteHeader()) return false;
+    std::string line;
+    while (std::getline(in, line)) {
+        size_t b = line.find_first_not_of(" \t\r");
+        if (b == std::string::npos || line[b] == '#') continue;
+        line = line.substr(b, line.find_last_not_of(" \t\r") - b + 1);
+
+        if (line == "quit") break;
+        if (line == "ping") {
+            if (!writer.WriteEnd(0, "pong")) return false;
+            continue;
+        }
+        ServiceRequest request;
+        std::string error;
+        if (!ServiceRequest::Parse(line, request, error)) {
+            if (!request.id.empty()) error = "id=" + request.id + " " + error;
+            if (!writer.WriteError(error)) return false;
+            continue;
+        }
+        if (!Handle(request, writer)) return false;
+    }
+    return writer.Flush();
+}
+
+bool GeneratorService::Handle(const ServiceRequest& request, FrameWriter& writer) {
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+
+    const uint64_t begin = request.first_index;
+    const uint64_t end = begin + request.count;
+    const int num_threads = static_cast<int>(
+        std::min<uint64_t>(workers_.size(), request.count));
+    const bool targeted = request.target_score >= 0.0;
+
+    std::atomic<uint64_t> next(begin);
+    std::atomic<uint64_t> delivered(0);
+    std::atomic<uint64_t> failed(0);
+    auto worker_main = [&](int w) {
+        InstanceGenerator& generator = workers_[w];
+        GenerationResult& result = results_[w];
+        for (uint64_t i = next.fetch_add(1); i < end; i = next.fetch_add(1)) {
+            if (targeted) {
+                result = generator.GenerateTargeted(request.params, i, request.target_score,
+                                                    request.target_tolerance);
+            } else {
+                generator.GenerateInto(request.params, i, result);
+            }
+            if (!result.success) {
+                failed.fetch_add(1);
+                if (!writer.WriteFailure(i, result.error_message)) {
+                    next.store(end);
+                    return;
+                }
+                continue;
+            }
+            if (!writer.WriteInstance(request.payload, i, result.instance,
+                                      result.estimate.score)) {
+                next.store(end);    // 输出已中断, 放弃剩余算例
+                return;
+            }
+            delivered.fetch_add(1);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    for (int w = 1; w < num_threads; w++) {
+        threads.emplace_back(worker_main, w);
+    }
+    worker_main(0);
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    double elapsed_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    char summary[128];
+    std::snprintf(summary, sizeof(summary), "seed=%d count=%llu delivered=%llu failed=%llu ms=%.3f",
+                  request.params.seed, static_cast<unsigned long long>(request.count),
+                  static_cast<unsigned long long>(delivered.load()),
+                  static_cast<unsigned long long>(failed.load()), elapsed_ms);
+    std::string text = request.id.empty() ? summary : "id=" + request.id + " " + summary;
+    return writer.WriteEnd(delivered.load(), text);
+}
@@ -0,0 +1,62 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// generator_service.h - 常驻生成服务 (--serve)
+// 进程启动时建好已校准的生成器池, 之后逐行读取请求, 以帧流 (见 stream_format.h) 返回算例,
+// 交互预览和集群派发无需每次启动进程、也不经过磁盘
+//
+// 请求 (每行一个, 以空白分隔的 key=value, 键名同 GeneratorParams::Set, 另有):
+//   count=N          算例数 (默认 1)            index=K          起始批内序号 (默认 0)
+//   format=csv|bin   帧格式 (默认 csv)           id=TOKEN         原样写回 END / ERR 帧
+//   target_score=S   目标难度                    tolerance=T      目标评分容差 (默认 0.05)
+// 例: "id=7 preset=hard seed=42 count=100 format=bin"
+// 批内第k个算例与 -s seed --index k 一致 (seed 须非零). 命令 "ping" 只回 END 帧, "quit" 退出
+
+#ifndef CS_2D_DATA_GENERATOR_SERVICE_H_
+#define CS_2D_DATA_GENERATOR_SERVICE_H_
+
+#include "generator.h"
+#include "stream_format.h"
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+struct ServiceRequest {
+    GeneratorParams params;
+    uint64_t count = 1;
+    uint64_t first_index = 0;
+    StreamPayload payload = StreamPayload::kCsv;
+    double target_score = -1.0;
+    double target_tolerance = 0.05;
+    std::string id;
+
+    // 解析一行请求; 失败时 error 给出原因
+    static bool Parse(const std::string& line, ServiceRequest& out, std::string& error);
+};
+
+class GeneratorService {
+public:
+    // num_workers 个生成器 (0 = 硬件线程数), 各持一份 estimator 副本
+    GeneratorService(int num_workers, RngEngine engine, const DifficultyEstimator& estimator);
+
+    // 逐行处理请求直到输入结束或 "quit"; 输出中断时返回 false
+    bool Run(std::istream& in, FrameWriter& writer);
+
+    // 处理一个请求: 以全部生成器并行生成, 算例帧按完成顺序写出, 最后写 END 帧;
+    // 生成失败的算例写 FAIL 帧 (index = 批内序号), 摘要中 failed= 为失败数
+    bool Handle(const ServiceRequest& request, FrameWriter& writer);
+
+    int NumWorkers() const { return static_cast<int>(workers_.size()); }
+
+private:
+    std::vector<InstanceGenerator> workers_;
+    std::vector<GenerationResult> results_;     // 每个生成器复用的结果缓冲区
+};
+
+#endif  // CS_2D_DATA_GENERATOR_SERVICE_H_
@@ -0,0 +1,232 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// generator_sweep.cpp - 参数扫描实现
+// 每个单元是一个独立批次 (种子 = 单元参数中的 seed), 第k个算例与 -s seed --index k 一致.
+// 单元间耗时差异大 (逆向生成多母板远慢于残差生成), 以工作窃取池调度:
+// 任务为 (单元, 序号区间), 执行前对半拆分, 后一半留在本线程队列供空闲线程窃取
+
+#include "generator.h"
+#include "csv_io.h"
+#include "sweep_spec.h"
+#include "work_stealing.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct SweepTask {
+    size_t cell = 0;
+    int begin = 0;
+    int end = 0;
+};
+
+// 清单中的一行 (按 单元 * count + 序号 预先分配)
+struct SweepRow {
+    bool success = false;
+    std::string file;           // 相对输出目录的路径
+    double score = 0.0;
+    const char* level = "";
+    double gen_ms = 0.0;
+};
+
+// 往返精确的浮点格式 (同 virtual_corpus.cpp), 清单中的参数可原样复现算例
+std::string Real(double v) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.17g", v);
+    return buf;
+}
+
+std::string CellDirName(size_t cell) {
+    std::ostringstream name;
+    name << "cell_" << std::setw(6) << std::setfill('0') << cell;
+    return name.str();
+}
+
+}  // namespace
+
+// 参数扫描
+bool InstanceGenerator::GenerateSweep(const SweepSpec& spec, const std::string& output_dir,
+    int default_seed, const BatchOptions& options) {
+
+    const size_t num_cells = spec.NumCells();
+    const int count = spec.Count();
+
+    // 未在规格中指定种子的单元共用一个基础种子 (0 则随机抽取并打印)
+    int base_seed = spec.Base().seed != 0 ? spec.Base().seed : default_seed;
+    if (base_seed == 0) {
+        base_seed = DrawSeed();
+    }
+
+    std::vector<GeneratorParams> cell_params(num_cells);
+    std::vector<char> cell_valid(num_cells, 0);
+    size_t num_valid = 0;
+    for (size_t c = 0; c < num_cells; c++) {
+        cell_params[c] = spec.CellParams(c);
+        if (cell_params[c].seed == 0) cell_params[c].seed = base_seed;
+        if (cell_params[c].Validate()) {
+            cell_valid[c] = 1;
+            num_valid++;
+            std::filesystem::create_directories(
+                std::filesystem::path(output_dir) / CellDirName(c));
+        } else {
+            std::cerr << "警告: 单元 " << c << " (" << spec.CellLabel(c)
+                      << ") 参数无效, 跳过" << std::endl;
+        }
+    }
+
+    int num_jobs = options.num_jobs;
+    if (num_jobs <= 0) {
+        num_jobs = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    const long long total = static_cast<long long>(num_valid) * count;
+    num_jobs = static_cast<int>(std::clamp<long long>(num_jobs, 1, std::max(1LL, total)));
+
+    std::cout << "参数扫描: " << num_cells << " 个单元 x " << count << " 个算例, "
+              << num_jobs << " 线程, 基础种子 " << base_seed << std::endl;
+
+    // 初始任务: 每个单元整体一个任务, 轮流分给各线程
+    WorkStealingPool<SweepTask> pool(num_jobs);
+    for (size_t c = 0, w = 0; c < num_cells; c++) {
+        if (!cell_valid[c]) continue;
+        pool.Push(static_cast<int>(w++ % num_jobs), SweepTask{c, 0, count});
+    }
+
+    std::vector<SweepRow> rows(num_cells * static_cast<size_t>(count));
+    std::vector<InstanceGenerator> workers;
+    std::vector<GenerationResult> results(num_jobs);
+    std::vector<CsvSerializer> serializers(num_jobs);
+    workers.reserve(num_jobs);
+    for (int w = 0; w < num_jobs; w++) {
+        workers.emplace_back(w + 1, engine_);
+        workers.back().estimator_ = estimator_;
+    }
+    const bool targeted = options.target_score >= 0.0;
+    std::mutex output_mutex;
+
+    auto start_time = Clock::now();
+    pool.Run([&](int w, SweepTask task) {
+        // 对半拆分, 本线程只保留一个算例
+        while (task.end - task.begin > 1) {
+            int mid = task.begin + (task.end - task.begin) / 2;
+            pool.Push(w, SweepTask{task.cell, mid, task.end});
+            task.end = mid;
+        }
+
+        const GeneratorParams& params = cell_params[task.cell];
+        const int k = task.begin;
+        SweepRow& row = rows[task.cell * count + k];
+        GenerationResult& result = results[w];
+
+        auto gen_start = Clock::now();
+        if (targeted) {
+            result = workers[w].GenerateTargeted(params, static_cast<uint64_t>(k),
+                options.target_score, options.target_tolerance);
+        } else {
+            workers[w].GenerateInto(params, static_cast<uint64_t>(k), result);
+        }
+        row.gen_ms = std::chrono::duration<double, std::milli>(Clock::now() - gen_start).count();
+        if (!result.success) {
+            std::lock_guard<std::mutex> lock(output_mutex);
+            std::cerr << "警告: 单元 " << task.cell << " 第 " << k << " 个算例生成失败 ("
+                      << result.error_message << ")" << std::endl;
+            return;
+        }
+
+        std::string cell_dir = (std::filesystem::path(output_dir) / CellDirName(task.cell)).string();
+        std::string filepath = GenerateFilename(params, cell_dir, result.estimate.score, k);
+        bool ok = serializers[w].Write(result.instance, filepath);
+        if (ok && options.certificates && !result.instance.certificate.Empty()) {
+            ok = ExportCertificate(result.instance, filepath);
+        }
+        if (!ok) return;
+
+        row.success = true;
+        row.file = std::filesystem::path(filepath).lexically_relative(output_dir).generic_string();
+        row.score = result.estimate.score;
+        row.level = DifficultyEstimator::LevelName(result.estimate.level);
+    });
+    double elapsed = std::chrono::duration<double>(Clock::now() - start_time).count();
+
+    // 清单: 每个成功算例一行, 按 (单元, 序号) 排序, 记录完整参数以便单独复现
+    std::string manifest_path = (std::filesystem::path(output_dir) / "manifest.csv").string();
+    std::ofstream manifest(manifest_path);
+    bool manifest_ok = manifest.is_open();
+    if (!manifest_ok) {
+        std::cerr << "Error: Cannot open file " << manifest_path << std::endl;
+    }
+    if (manifest_ok) manifest << "cell,index,file,num_types,stock_width,stock_length,min_size_ratio,"
+                "max_size_ratio,size_cv,min_demand,max_demand,demand_skew,prime_offset,"
+                "num_clusters,peak_ratio,large_scale,strategy,rng,seed,score,level,gen_ms\n";
+
+    size_t num_ok = 0;
+    std::cout << "\n";
+    for (size_t c = 0; c < num_cells; c++) {
+        if (!cell_valid[c]) continue;
+        const GeneratorParams& p = cell_params[c];
+        int cell_ok = 0;
+        double score_sum = 0.0;
+        double ms_sum = 0.0;
+        for (int k = 0; k < count; k++) {
+            const SweepRow& row = rows[c * count + k];
+            ms_sum += row.gen_ms;
+            if (!row.success) continue;
+            cell_ok++;
+            score_sum += row.score;
+            if (!manifest_ok) continue;
+            manifest << c << ',' << k << ',' << row.file << ',' << p.num_types << ','
+                     << p.stock_width << ',' << p.stock_length << ',' << Real(p.min_size_ratio) << ','
+                     << Real(p.max_size_ratio) << ',' << Real(p.size_cv) << ',' << p.min_demand
+                     << ',' << p.max_demand << ',' << Real(p.demand_skew) << ','
+                     << (p.prime_offset ? 1 : 0) << ',' << p.num_clusters << ','
+                     << Real(p.peak_ratio) << ','
+                     << (p.large_scale ? 1 : 0) << ',' << p.strategy << ','
+                     << RngEngineName(engine_) << ',' << p.seed << ','
+                     << std::fixed << std::setprecision(4) << row.score << ',' << row.level
+                     << ',' << std::setprecision(3) << row.gen_ms
+                     << std::defaultfloat << std::setprecision(6) << '\n';
+        }
+        num_ok += cell_ok;
+        std::cout << CellDirName(c) << " [" << spec.CellLabel(c) << "]: " << cell_ok << "/"
+                  << count << " 个";
+        if (cell_ok > 0) {
+            std::cout << ", 平均评分 " << std::fixed << std::setprecision(2)
+                      << score_sum / cell_ok;
+        }
+        std::cout << ", 平均用时 " << std::fixed << std::setprecision(3) << ms_sum / count
+                  << " ms" << std::defaultfloat << std::endl;
+    }
+    if (manifest_ok) {
+        manifest.close();
+        manifest_ok = !manifest.fail();
+        if (!manifest_ok) {
+            std::cerr << "Error: Failed to write " << manifest_path << std::endl;
+        }
+    }
+
+    std::cout << "\n扫描完成: " << num_ok << "/" << total << " 个算例, " << num_valid << " 个单元, 用时 "
+              << std::fixed << std::setprecision(2) << elapsed << " 秒";
+    if (elapsed > 0.0) {
+        std::cout << " (" << std::setprecision(1) << num_ok / elapsed << " 个/秒)";
+    }
+    std::cout << ", 任务窃取 " << pool.Steals() << " 次" << std::endl;
+    if (!manifest_ok) return false;
+    std::cout << "清单: " << manifest_path << std::endl;
+    return true;
+}
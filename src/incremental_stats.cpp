@@ -0,0 +1,108 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// incremental_stats.cpp - 增量算例统计量实现
+
+#include "incremental_stats.h"
+#include <algorithm>
+
+void IncrementalStats::Reset(int stock_width, int stock_length) {
+    stock_width_ = stock_width;
+    stock_length_ = stock_length;
+    count_ = 0;
+    total_demand_ = 0;
+    total_demand_area_ = 0;
+    sum_area_ = 0;
+    sum_w_ = 0;
+    sum_w2_ = 0;
+    sum_l_ = 0;
+    sum_l2_ = 0;
+    sum_d2_ = 0;
+    std::fill(width_count_.begin(), width_count_.end(), 0);
+    num_unique_widths_ = 0;
+    area_count_.clear();
+}
+
+void IncrementalStats::Reset(const Instance& inst) {
+    Reset(inst.stock_width, inst.stock_length);
+    for (const auto& item : inst.items) {
+        Add(item);
+    }
+}
+
+void IncrementalStats::Add(const Item& item) {
+    long long area = item.Area();
+    count_++;
+    total_demand_ += item.demand;
+    total_demand_area_ += area * item.demand;
+    sum_area_ += area;
+    sum_w_ += item.width;
+    sum_w2_ += static_cast<long long>(item.width) * item.width;
+    sum_l_ += item.length;
+    sum_l2_ += static_cast<long long>(item.length) * item.length;
+    sum_d2_ += static_cast<long long>(item.demand) * item.demand;
+
+    if (item.width >= static_cast<int>(width_count_.size())) {
+        width_count_.resize(item.width + 1, 0);
+    }
+    if (width_count_[item.width]++ == 0) {
+        num_unique_widths_++;
+    }
+    area_count_[item.Area()]++;
+}
+
+void IncrementalStats::Remove(const Item& item) {
+    long long area = item.Area();
+    count_--;
+    total_demand_ -= item.demand;
+    total_demand_area_ -= area * item.demand;
+    sum_area_ -= area;
+    sum_w_ -= item.width;
+    sum_w2_ -= static_cast<long long>(item.width) * item.width;
+    sum_l_ -= item.length;
+    sum_l2_ -= static_cast<long long>(item.length) * item.length;
+    sum_d2_ -= static_cast<long long>(item.demand) * item.demand;
+
+    if (--width_count_[item.width] == 0) {
+        num_unique_widths_--;
+    }
+    auto it = area_count_.find(item.Area());
+    if (it != area_count_.end() && --it->second == 0) {
+        area_count_.erase(it);
+    }
+}
+
+void IncrementalStats::Modify(const Item& old_item, const Item& new_item) {
+    Remove(old_item);
+    Add(new_item);
+}
+
+InstanceStats IncrementalStats::Stats() const {
+    InstanceStats st;
+    st.stock_width = stock_width_;
+    st.stock_length = stock_length_;
+    st.num_types = count_;
+    st.total_demand = static_cast<int>(total_demand_);
+    st.total_demand_area = total_demand_area_;
+    st.sum_item_area = static_cast<double>(sum_area_);
+    st.num_unique_widths = num_unique_widths_;
+    if (count_ == 0) return st;
+
+    st.min_item_area = area_count_.begin()->first;
+    st.max_item_area = area_count_.rbegin()->first;
+
+    // 由幂和恢复均值与离差平方和: M2 = (n*S2 - S1^2) / n
+    double n = count_;
+    st.mean_width = sum_w_ / n;
+    st.m2_width = static_cast<double>(count_ * sum_w2_ - sum_w_ * sum_w_) / n;
+    st.mean_length = sum_l_ / n;
+    st.m2_length = static_cast<double>(count_ * sum_l2_ - sum_l_ * sum_l_) / n;
+    st.mean_demand = total_demand_ / n;
+    st.m2_demand = static_cast<double>(count_ * sum_d2_ - total_demand_ * total_demand_) / n;
+    return st;
+}
@@ -0,0 +1,67 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// incremental_stats.h - 增量算例统计量
+// 单个子板的增/删/改以 O(1) (面积极值 O(log n)) 更新统计量与难度评分,
+// 用于逐子板变异的局部搜索调优
+
+#ifndef CS_2D_DATA_INCREMENTAL_STATS_H_
+#define CS_2D_DATA_INCREMENTAL_STATS_H_
+
+#include "instance.h"
+#include "difficulty_estimator.h"
+#include <map>
+#include <vector>
+
+class IncrementalStats {
+public:
+    IncrementalStats() = default;
+
+    // 清空并设置母板尺寸
+    void Reset(int stock_width, int stock_length);
+
+    // 由完整算例重建 (O(n))
+    void Reset(const Instance& inst);
+
+    // 单子板增/删/改
+    void Add(const Item& item);
+    void Remove(const Item& item);
+    void Modify(const Item& old_item, const Item& new_item);
+
+    // 当前子板类型数
+    int NumTypes() const { return count_; }
+
+    // 当前统计量快照 (O(1), 与 InstanceStats::Compute 结果一致)
+    InstanceStats Stats() const;
+
+    // 当前综合难度评分
+    double Score(const DifficultyEstimator& estimator) const {
+        return estimator.Score(Stats());
+    }
+
+private:
+    int stock_width_ = 0;
+    int stock_length_ = 0;
+    int count_ = 0;
+
+    // 整数幂和 (精确, 删除时无舍入累积)
+    long long total_demand_ = 0;
+    long long total_demand_area_ = 0;
+    long long sum_area_ = 0;
+    long long sum_w_ = 0;
+    long long sum_w2_ = 0;
+    long long sum_l_ = 0;
+    long long sum_l2_ = 0;
+    long long sum_d2_ = 0;
+
+    std::vector<int> width_count_;      // 宽度 -> 子板类型数
+    int num_unique_widths_ = 0;
+    std::map<int, int> area_count_;     // 面积 -> 子板类型数 (维护极值)
+};
+
+#endif  // CS_2D_DATA_INCREMENTAL_STATS_H_
@@ -8,17 +8,20 @@
 
 // instance.h - 2D Cutting Stock Problem Instance Data Structures
 // Project: CS-2D-Data
-// Purpose: Define Instance and Item structures with statistics methods
+// Purpose: Define Instance and Item structures with cached single-pass statistics
 
 #ifndef CS_2D_DATA_INSTANCE_H_
 #define CS_2D_DATA_INSTANCE_H_
 
+#include "certificate.h"
 #include <vector>
 #include <string>
 #include <cmath>
 #include <algorithm>
 #include <numeric>
-#include <set>
+#include <cstdio>
+#include <cstdint>
+#include <type_traits>
 
 // Item type definition
 struct Item {
@@ -36,170 +39,281 @@ struct Item {
     }
 };
 
-// Instance definition with statistics methods
-struct Instance {
-    int stock_width;              // Stock width W
-    int stock_length;             // Stock length L
-    std::vector<Item> items;      // List of item types
-    int known_optimal;            // Known optimal solution (-1 if unknown)
-    double difficulty;            // Difficulty parameter used for generation
-
-    // Constructor
-    Instance() : stock_width(0), stock_length(0), known_optimal(-1), difficulty(0.0) {}
-
-    // Stock area
-    int StockArea() const { return stock_width * stock_length; }
-
-    // Number of item types
-    int NumTypes() const { return static_cast<int>(items.size()); }
+// Item is a plain record of four ints {id, width, length, demand}; an items
+// array can be handed to C or solver code as-is
+static_assert(sizeof(Item) == 4 * sizeof(int), "Item must stay a flat record of four ints");
+static_assert(std::is_standard_layout<Item>::value && std::is_trivially_copyable<Item>::value,
+              "Item must stay a flat record of four ints");
+
+// Borrowed read-only view of an instance's items (no copy).
+// Valid while the owning Instance is alive and its items are not resized.
+struct ItemsView {
+    const Item* data = nullptr;
+    size_t size = 0;
+    int stock_width = 0;
+    int stock_length = 0;
+
+    const Item* begin() const { return data; }
+    const Item* end() const { return data + size; }
+    const Item& operator[](size_t i) const { return data[i]; }
+    bool empty() const { return size == 0; }
+};
 
-    // Total demand (sum of all d_i)
-    int TotalDemand() const {
-        int total = 0;
+// Instance statistics computed in one fused pass over the items
+// (Welford moments for width/length/demand, mark table for unique widths)
+struct InstanceStats {
+    int stock_width = 0;
+    int stock_length = 0;
+    int num_types = 0;
+    int total_demand = 0;
+    long long total_demand_area = 0;
+    double sum_item_area = 0.0;
+    int min_item_area = 0;
+    int max_item_area = 0;
+    int num_unique_widths = 0;
+
+    // Running means and sums of squared deviations (Welford)
+    double mean_width = 0.0;
+    double m2_width = 0.0;
+    double mean_length = 0.0;
+    double m2_length = 0.0;
+    double mean_demand = 0.0;
+    double m2_demand = 0.0;
+    // Distinct stage-2 strip fill lengths summed over strip widths
+    // (set by the difficulty estimator from the items; -1 = not computed)
+    double strip_patterns = -1.0;
+
+    // Compute all statistics in a single pass
+    static InstanceStats Compute(int stock_width, int stock_length,
+                                 const std::vector<Item>& items) {
+        InstanceStats st;
+        st.stock_width = stock_width;
+        st.stock_length = stock_length;
+        st.num_types = static_cast<int>(items.size());
+        if (items.empty()) return st;
+
+        st.min_item_area = items[0].Area();
+        st.max_item_area = items[0].Area();
+
+        // Reusable per-thread mark table for width multiplicity
+        thread_local std::vector<unsigned char> width_marks;
+        constexpr int kMaxMarkedWidth = 1 << 20;
+        bool marks_usable = true;
+
+        double n = 0.0;
         for (const auto& item : items) {
-            total += item.demand;
+            int area = item.Area();
+            st.total_demand += item.demand;
+            st.total_demand_area += static_cast<long long>(area) * item.demand;
+            st.sum_item_area += area;
+            st.min_item_area = std::min(st.min_item_area, area);
+            st.max_item_area = std::max(st.max_item_area, area);
+
+            n += 1.0;
+            double dw = item.width - st.mean_width;
+            st.mean_width += dw / n;
+            st.m2_width += dw * (item.width - st.mean_width);
+            double dl = item.length - st.mean_length;
+            st.mean_length += dl / n;
+            st.m2_length += dl * (item.length - st.mean_length);
+            double dd = item.demand - st.mean_demand;
+            st.mean_demand += dd / n;
+            st.m2_demand += dd * (item.demand - st.mean_demand);
+
+            if (item.width < 0 || item.width >= kMaxMarkedWidth) {
+                marks_usable = false;
+            } else if (marks_usable) {
+                if (item.width >= static_cast<int>(width_marks.size())) {
+                    width_marks.resize(item.width + 1, 0);
+                }
+                if (!width_marks[item.width]) {
+                    width_marks[item.width] = 1;
+                    st.num_unique_widths++;
+                }
+            }
         }
-        return total;
-    }
 
-    // Total demand area (sum of w_i * l_i * d_i)
-    long long TotalDemandArea() const {
-        long long total = 0;
+        // Reset only the touched marks
         for (const auto& item : items) {
-            total += static_cast<long long>(item.Area()) * item.demand;
+            if (item.width >= 0 && item.width < static_cast<int>(width_marks.size())) {
+                width_marks[item.width] = 0;
+            }
         }
-        return total;
+
+        // Out-of-range widths (invalid items only): fall back to sort + unique
+        if (!marks_usable) {
+            std::vector<int> widths;
+            widths.reserve(items.size());
+            for (const auto& item : items) widths.push_back(item.width);
+            std::sort(widths.begin(), widths.end());
+            st.num_unique_widths = static_cast<int>(
+                std::unique(widths.begin(), widths.end()) - widths.begin());
+        }
+        return st;
+    }
+
+    long long StockArea() const {
+        return static_cast<long long>(stock_width) * stock_length;
     }
 
-    // Theoretical lower bound on plates needed
     double TheoreticalLowerBound() const {
         if (StockArea() == 0) return 0.0;
-        return static_cast<double>(TotalDemandArea()) / StockArea();
+        return static_cast<double>(total_demand_area) / StockArea();
     }
 
-    // Average item area
     double AvgItemArea() const {
-        if (items.empty()) return 0.0;
-        double sum = 0.0;
-        for (const auto& item : items) {
-            sum += item.Area();
-        }
-        return sum / items.size();
+        return num_types > 0 ? sum_item_area / num_types : 0.0;
     }
 
-    // Average size ratio (item_area / stock_area)
     double AvgSizeRatio() const {
         if (StockArea() == 0) return 0.0;
         return AvgItemArea() / StockArea();
     }
 
-    // Average width ratio
     double AvgWidthRatio() const {
-        if (items.empty() || stock_width == 0) return 0.0;
-        double sum = 0.0;
-        for (const auto& item : items) {
-            sum += static_cast<double>(item.width) / stock_width;
-        }
-        return sum / items.size();
+        if (num_types == 0 || stock_width == 0) return 0.0;
+        return mean_width / stock_width;
     }
 
-    // Average length ratio
     double AvgLengthRatio() const {
-        if (items.empty() || stock_length == 0) return 0.0;
-        double sum = 0.0;
-        for (const auto& item : items) {
-            sum += static_cast<double>(item.length) / stock_length;
-        }
-        return sum / items.size();
+        if (num_types == 0 || stock_length == 0) return 0.0;
+        return mean_length / stock_length;
     }
 
-    // Average demand per item type
     double AvgDemand() const {
-        if (items.empty()) return 0.0;
-        return static_cast<double>(TotalDemand()) / items.size();
+        return num_types > 0 ? static_cast<double>(total_demand) / num_types : 0.0;
     }
 
-    // Demand variance
+    // Sample variance of demand
     double DemandVariance() const {
-        if (items.size() < 2) return 0.0;
-        double avg = AvgDemand();
-        double sum_sq = 0.0;
-        for (const auto& item : items) {
-            double diff = item.demand - avg;
-            sum_sq += diff * diff;
-        }
-        return sum_sq / (items.size() - 1);
+        return num_types >= 2 ? m2_demand / (num_types - 1) : 0.0;
     }
 
-    // Demand coefficient of variation (std / mean)
     double DemandCV() const {
         double avg = AvgDemand();
         if (avg < 1e-9) return 0.0;
         return std::sqrt(DemandVariance()) / avg;
     }
 
-    // Size coefficient of variation (combined width and length)
+    // Combined width/length coefficient of variation
     double SizeCV() const {
-        if (items.size() < 2) return 0.0;
+        if (num_types < 2) return 0.0;
+        double var_w = m2_width / (num_types - 1);
+        double var_l = m2_length / (num_types - 1);
+        double cv_w = (mean_width > 0) ? std::sqrt(var_w) / mean_width : 0.0;
+        double cv_l = (mean_length > 0) ? std::sqrt(var_l) / mean_length : 0.0;
+        return std::sqrt((cv_w * cv_w + cv_l * cv_l) / 2.0);
+    }
 
-        // Calculate mean width and length
-        double mean_w = 0.0, mean_l = 0.0;
-        for (const auto& item : items) {
-            mean_w += item.width;
-            mean_l += item.length;
-        }
-        mean_w /= items.size();
-        mean_l /= items.size();
+    double WidthDiversity() const {
+        return num_types > 0 ? static_cast<double>(num_unique_widths) / num_types : 0.0;
+    }
 
-        // Calculate variance
-        double var_w = 0.0, var_l = 0.0;
-        for (const auto& item : items) {
-            var_w += (item.width - mean_w) * (item.width - mean_w);
-            var_l += (item.length - mean_l) * (item.length - mean_l);
+    double MinSizeRatio() const {
+        if (num_types == 0 || StockArea() == 0) return 0.0;
+        return static_cast<double>(min_item_area) / StockArea();
+    }
+
+    double MaxSizeRatio() const {
+        if (num_types == 0 || StockArea() == 0) return 0.0;
+        return static_cast<double>(max_item_area) / StockArea();
+    }
+};
+
+// Instance definition with statistics methods
+// Statistics are served from a lazily computed InstanceStats cache;
+// call InvalidateStats() after modifying stock dimensions or items.
+// Thread safety: the first Stats() call on an unprimed instance writes the
+// cache, so concurrent Stats() calls on a shared const Instance are only safe
+// once the cache is primed. Instances finalized by the generator
+// (ValidateAndFix, TuneTowardTarget), CsvReader::Parse and
+// InstanceView::ToInstance are primed; call RefreshStats() after your own edits
+// before sharing an instance across threads.
+struct Instance {
+    int stock_width;              // Stock width W
+    int stock_length;             // Stock length L
+    std::vector<Item> items;      // List of item types
+    int known_optimal;            // Known optimal solution (-1 if unknown)
+    double difficulty;            // Difficulty parameter used for generation
+    PackingCertificate certificate;   // Known feasible packing (empty if none)
+    uint64_t fingerprint;         // Canonical content hash (see fingerprint.h; 0 = not computed)
+
+    // Constructor
+    Instance() : stock_width(0), stock_length(0), known_optimal(-1), difficulty(0.0),
+                 fingerprint(0) {}
+
+    // Cached single-pass statistics
+    const InstanceStats& Stats() const {
+        if (!stats_valid_) {
+            stats_ = InstanceStats::Compute(stock_width, stock_length, items);
+            stats_valid_ = true;
         }
-        var_w /= (items.size() - 1);
-        var_l /= (items.size() - 1);
+        return stats_;
+    }
 
-        // Combined CV
-        double cv_w = (mean_w > 0) ? std::sqrt(var_w) / mean_w : 0.0;
-        double cv_l = (mean_l > 0) ? std::sqrt(var_l) / mean_l : 0.0;
+    // Drop cached statistics after a mutation
+    void InvalidateStats() { stats_valid_ = false; }
 
-        return std::sqrt((cv_w * cv_w + cv_l * cv_l) / 2.0);
+    // Recompute cached statistics now (prime the cache of a finalized instance)
+    void RefreshStats() {
+        stats_ = InstanceStats::Compute(stock_width, stock_length, items);
+        stats_valid_ = true;
     }
 
-    // Number of unique widths (equals number of strip types)
-    int NumUniqueWidths() const {
-        std::set<int> widths;
-        for (const auto& item : items) {
-            widths.insert(item.width);
-        }
-        return static_cast<int>(widths.size());
+    // Borrow the items array without copying
+    ItemsView Items() const {
+        return ItemsView{items.data(), items.size(), stock_width, stock_length};
     }
 
+    // Stock area
+    int StockArea() const { return stock_width * stock_length; }
+
+    // Number of item types
+    int NumTypes() const { return static_cast<int>(items.size()); }
+
+    // Total demand (sum of all d_i)
+    int TotalDemand() const { return Stats().total_demand; }
+
+    // Total demand area (sum of w_i * l_i * d_i)
+    long long TotalDemandArea() const { return Stats().total_demand_area; }
+
+    // Theoretical lower bound on plates needed
+    double TheoreticalLowerBound() const { return Stats().TheoreticalLowerBound(); }
+
+    // Average item area
+    double AvgItemArea() const { return Stats().AvgItemArea(); }
+
+    // Average size ratio (item_area / stock_area)
+    double AvgSizeRatio() const { return Stats().AvgSizeRatio(); }
+
+    // Average width ratio
+    double AvgWidthRatio() const { return Stats().AvgWidthRatio(); }
+
+    // Average length ratio
+    double AvgLengthRatio() const { return Stats().AvgLengthRatio(); }
+
+    // Average demand per item type
+    double AvgDemand() const { return Stats().AvgDemand(); }
+
+    // Demand variance
+    double DemandVariance() const { return Stats().DemandVariance(); }
+
+    // Demand coefficient of variation (std / mean)
+    double DemandCV() const { return Stats().DemandCV(); }
+
+    // Size coefficient of variation (combined width and length)
+    double SizeCV() const { return Stats().SizeCV(); }
+
+    // Number of unique widths (equals number of strip types)
+    int NumUniqueWidths() const { return Stats().num_unique_widths; }
+
     // Width diversity ratio (unique_widths / num_types)
-    double WidthDiversity() const {
-        if (items.empty()) return 0.0;
-        return static_cast<double>(NumUniqueWidths()) / items.size();
-    }
+    double WidthDiversity() const { return Stats().WidthDiversity(); }
 
     // Min/Max size ratios
-    double MinSizeRatio() const {
-        if (items.empty() || StockArea() == 0) return 0.0;
-        int min_area = items[0].Area();
-        for (const auto& item : items) {
-            min_area = std::min(min_area, item.Area());
-        }
-        return static_cast<double>(min_area) / StockArea();
-    }
+    double MinSizeRatio() const { return Stats().MinSizeRatio(); }
 
-    double MaxSizeRatio() const {
-        if (items.empty() || StockArea() == 0) return 0.0;
-        int max_area = items[0].Area();
-        for (const auto& item : items) {
-            max_area = std::max(max_area, item.Area());
-        }
-        return static_cast<double>(max_area) / StockArea();
-    }
+    double MaxSizeRatio() const { return Stats().MaxSizeRatio(); }
 
     // Validate instance (all items fit in stock)
     bool IsValid() const {
@@ -216,6 +330,7 @@ struct Instance {
 
     // Print statistics summary
     std::string GetStatsSummary() const {
+        const InstanceStats& st = Stats();
         char buf[1024];
         snprintf(buf, sizeof(buf),
             "Instance Statistics:\n"
@@ -232,17 +347,21 @@ struct Instance {
             "  Known optimal: %d\n",
             stock_width, stock_length, StockArea(),
             NumTypes(),
-            TotalDemand(),
-            TotalDemandArea(),
-            TheoreticalLowerBound(),
-            AvgSizeRatio() * 100,
-            SizeCV(),
-            AvgDemand(),
-            DemandCV(),
-            NumUniqueWidths(), WidthDiversity(),
+            st.total_demand,
+            st.total_demand_area,
+            st.TheoreticalLowerBound(),
+            st.AvgSizeRatio() * 100,
+            st.SizeCV(),
+            st.AvgDemand(),
+            st.DemandCV(),
+            st.num_unique_widths, st.WidthDiversity(),
             known_optimal);
         return std::string(buf);
     }
+
+private:
+    mutable InstanceStats stats_;     // Cached statistics
+    mutable bool stats_valid_ = false;
 };
 
 #endif  // CS_2D_DATA_INSTANCE_H_
@@ -0,0 +1,54 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// instrumentation.cpp - 计数器合并与 JSON 输出
+
+#include "instrumentation.h"
+#include <cstdio>
+#include <utility>
+
+void GenerationCounters::Merge(const GenerationCounters& other) {
+    instances += other.instances;
+    size_attempts += other.size_attempts;
+    size_collisions += other.size_collisions;
+    dropped_types += other.dropped_types;
+    fix_removed += other.fix_removed;
+    fix_added += other.fix_added;
+    optimal_lost += other.optimal_lost;
+    generate_ns += other.generate_ns;
+    validate_ns += other.validate_ns;
+    estimate_ns += other.estimate_ns;
+    export_ns += other.export_ns;
+}
+
+std::string GenerationCounters::ToJson(int indent) const {
+    const std::string pad(indent, ' ');
+    const std::pair<const char*, uint64_t> fields[] = {
+        {"instances", instances},
+        {"size_attempts", size_attempts},
+        {"size_collisions", size_collisions},
+        {"dropped_types", dropped_types},
+        {"fix_removed", fix_removed},
+        {"fix_added", fix_added},
+        {"optimal_lost", optimal_lost},
+        {"generate_ns", generate_ns},
+        {"validate_ns", validate_ns},
+        {"estimate_ns", estimate_ns},
+        {"export_ns", export_ns},
+    };
+    std::string json = "{\n";
+    const size_t n = sizeof(fields) / sizeof(fields[0]);
+    for (size_t i = 0; i < n; i++) {
+        char line[96];
+        std::snprintf(line, sizeof(line), "\"%s\": %llu%s\n", fields[i].first,
+                      static_cast<unsigned long long>(fields[i].second), i + 1 < n ? "," : "");
+        json += pad + line;
+    }
+    json += std::string(indent >= 2 ? indent - 2 : 0, ' ') + "}";
+    return json;
+}
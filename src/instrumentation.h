@@ -0,0 +1,76 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// instrumentation.h - 生成热路径计数器与计时器
+// 以 -DCS2D_DATA_INSTRUMENT=ON 构建时启用; 关闭时 CS2D_COUNT / CS2D_TIME_SCOPE 展开为空,
+// 热路径上不留任何指令. 计数器由每个生成器 (即每个工作线程) 独占, 无原子操作, 批次结束时合并
+
+#ifndef CS_2D_DATA_INSTRUMENTATION_H_
+#define CS_2D_DATA_INSTRUMENTATION_H_
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#ifndef CS2D_DATA_INSTRUMENT
+#define CS2D_DATA_INSTRUMENT 0
+#endif
+
+struct GenerationCounters {
+    static constexpr bool kEnabled = CS2D_DATA_INSTRUMENT != 0;
+
+    uint64_t instances = 0;         // 按策略生成的算例数 (含目标难度模式的重新生成)
+    uint64_t size_attempts = 0;     // 去重循环中的尺寸抽取/调整次数
+    uint64_t size_collisions = 0;   // 其中与已有尺寸重复的次数
+    uint64_t dropped_types = 0;     // 去重放弃而少生成的子板种类
+    uint64_t fix_removed = 0;       // ValidateAndFix 移除的无效子板
+    uint64_t fix_added = 0;         // ValidateAndFix 为凑足 3 种补充的子板
+    uint64_t optimal_lost = 0;      // 失去已知最优解的算例 (逆向补足子板 / 调优变异)
+
+    // 各阶段累计用时 (纳秒)
+    uint64_t generate_ns = 0;       // 策略生成 (不含验证修正)
+    uint64_t validate_ns = 0;       // 验证修正
+    uint64_t estimate_ns = 0;       // 难度预估与下界
+    uint64_t export_ns = 0;         // 序列化与写出
+
+    void Merge(const GenerationCounters& other);
+
+    // JSON 对象 (不含首尾换行), indent 为各字段的缩进空格数
+    std::string ToJson(int indent) const;
+};
+
+// 作用域计时: 析构时把经过的纳秒数累加到 counter
+class ScopedNsTimer {
+public:
+    explicit ScopedNsTimer(uint64_t& counter)
+        : counter_(counter), start_(std::chrono::steady_clock::now()) {}
+    ~ScopedNsTimer() {
+        counter_ += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start_).count());
+    }
+
+    ScopedNsTimer(const ScopedNsTimer&) = delete;
+    ScopedNsTimer& operator=(const ScopedNsTimer&) = delete;
+
+private:
+    uint64_t& counter_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+#define CS2D_CONCAT_INNER(a, b) a##b
+#define CS2D_CONCAT(a, b) CS2D_CONCAT_INNER(a, b)
+
+#if CS2D_DATA_INSTRUMENT
+#define CS2D_COUNT(counter, n) ((counter) += static_cast<uint64_t>(n))
+#define CS2D_TIME_SCOPE(counter) ScopedNsTimer CS2D_CONCAT(cs2d_timer_, __LINE__)(counter)
+#else
+#define CS2D_COUNT(counter, n) ((void)0)
+#define CS2D_TIME_SCOPE(counter) ((void)0)
+#endif
+
+#endif  // CS_2D_DATA_INSTRUMENTATION_H_
@@ -0,0 +1,240 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// lower_bounds.cpp - 母板数的组合下界与启发式上界实现
+
+#include "lower_bounds.h"
+#include <algorithm>
+
+namespace {
+
+long long CeilDiv(long long a, long long b) {
+    return a <= 0 ? 0 : (a + b - 1) / b;
+}
+
+}  // namespace
+
+const BoundReport& BoundCalculator::ComputeLower(const Instance& inst) {
+    report_ = BoundReport();
+    const long long stock_area =
+        static_cast<long long>(inst.stock_width) * inst.stock_length;
+    if (stock_area <= 0 || inst.items.empty()) return report_;
+
+    report_.area = static_cast<int>(CeilDiv(inst.Stats().total_demand_area, stock_area));
+    report_.mv_l1 = std::max(MartelloVigoL1(inst, true), MartelloVigoL1(inst, false));
+    report_.mv_l2 = MartelloVigoL2(inst);
+    report_.strip = StripKnapsackBound(inst);
+    report_.lower = std::max({report_.area, report_.mv_l1, report_.mv_l2, report_.strip});
+    report_.utilization_lb = static_cast<double>(inst.Stats().total_demand_area)
+                           / (report_.lower * static_cast<double>(stock_area));
+    return report_;
+}
+
+// Martello-Vigo L1: 在一个方向上对"另一边过半"的子板做一维装箱下界
+// 对 alpha in [1, C/2]: J1 = (C-alpha, C], J2 = (C/2, C-alpha], J3 = [alpha, C/2]
+// L(alpha) = |J1|+|J2| + max(ceil((S(J3) - (|J2|C - S(J2))) / C),
+//                             ceil((|J3| - sum_{J2} floor((C-x)/alpha)) / floor(C/alpha)))
+int BoundCalculator::MartelloVigoL1(const Instance& inst, bool width_dimension) {
+    const int capacity = width_dimension ? inst.stock_width : inst.stock_length;
+    const int other = width_dimension ? inst.stock_length : inst.stock_width;
+    const int half = capacity / 2;
+
+    count_by_size_.assign(capacity + 1, 0);
+    for (const auto& item : inst.items) {
+        int size = width_dimension ? item.width : item.length;
+        int cross = width_dimension ? item.length : item.width;
+        if (2 * cross > other && size >= 1 && size <= capacity) {
+            count_by_size_[size] += item.demand;
+        }
+    }
+
+    // 过半子板总数与前缀计数/和 (按尺寸)
+    long long num_big = 0;
+    nonzero_sizes_.clear();
+    for (int x = 1; x <= capacity; x++) {
+        if (count_by_size_[x] == 0) continue;
+        nonzero_sizes_.push_back(x);
+        if (2 * x > capacity) num_big += count_by_size_[x];
+    }
+    if (nonzero_sizes_.empty()) return 0;
+
+    long long best = num_big;
+    // alpha 只需取 J3 中出现的尺寸
+    for (int alpha : nonzero_sizes_) {
+        if (alpha > half) break;
+        long long n2 = 0, s2 = 0, fill2 = 0, n3 = 0, s3 = 0;
+        for (int x : nonzero_sizes_) {
+            long long c = count_by_size_[x];
+            if (x >= alpha && x <= half) {
+                n3 += c;
+                s3 += c * x;
+            } else if (x > half && x <= capacity - alpha) {
+                n2 += c;
+                s2 += c * x;
+                fill2 += c * ((capacity - x) / alpha);
+            }
+        }
+        long long by_size = CeilDiv(s3 - (n2 * capacity - s2), capacity);
+        long long by_count = CeilDiv(n3 - fill2, capacity / alpha);
+        best = std::max(best, num_big + std::max(by_size, by_count));
+    }
+    return static_cast<int>(best);
+}
+
+// Martello-Vigo L2: 对 (p, q), I1 = {w > W-p, l > L-q}, I2 = 其余两边均过半者,
+// I3 = {p <= w <= W/2, q <= l <= L/2}; I3 放不进 I1 所在母板, 只能占用 I2 母板的剩余面积
+// L2(p, q) = |I1|+|I2| + max(0, ceil((A(I3) - sum_{I2}(WL - a_j)) / WL))
+int BoundCalculator::MartelloVigoL2(const Instance& inst) {
+    const int W = inst.stock_width;
+    const int L = inst.stock_length;
+    const long long stock_area = static_cast<long long>(W) * L;
+
+    long long num_big = 0;
+    for (const auto& item : inst.items) {
+        if (2 * item.width > W && 2 * item.length > L) num_big += item.demand;
+    }
+
+    const int n = static_cast<int>(inst.items.size());
+    const int stride = std::max(1, n / kMaxL2Candidates);
+    long long best = num_big;
+    for (int k = 0; k < n; k += stride) {
+        const int p = inst.items[k].width;
+        const int q = inst.items[k].length;
+        if (2 * p > W || 2 * q > L) continue;
+
+        long long i2_free = 0, i3_area = 0;
+        for (const auto& item : inst.items) {
+            long long area = static_cast<long long>(item.width) * item.length;
+            if (2 * item.width > W && 2 * item.length > L) {
+                if (!(item.width > W - p && item.length > L - q)) {
+                    i2_free += item.demand * (stock_area - area);
+                }
+            } else if (item.width >= p && 2 * item.width <= W &&
+                       item.length >= q && 2 * item.length <= L) {
+                i3_area += item.demand * area;
+            }
+        }
+        best = std::max(best, num_big + CeilDiv(i3_area - i2_free, stock_area));
+    }
+    return static_cast<int>(best);
+}
+
+// 条带背包下界
+int BoundCalculator::StripKnapsackBound(const Instance& inst) {
+    const int W = inst.stock_width;
+    const int L = inst.stock_length;
+
+    by_width_.clear();
+    for (const auto& item : inst.items) {
+        by_width_.emplace_back(item.width, item.length);
+    }
+    std::sort(by_width_.begin(), by_width_.end());
+
+    // 按宽度升序逐步加入长度, 每个不同宽度 s 处记录 L*(s)
+    reach_.Reset(L);
+    strip_widths_.clear();
+    strip_values_.clear();
+    long long best_single = 0;
+    for (size_t i = 0; i < by_width_.size();) {
+        const int s = by_width_[i].first;
+        for (; i < by_width_.size() && by_width_[i].first == s; i++) {
+            // 已可达的长度是已有长度之和, 重复加入不会扩大可达集合
+            if (!reach_.Test(by_width_[i].second)) {
+                reach_.AddUnbounded(by_width_[i].second);
+            }
+        }
+        if (s > W) continue;
+        long long value = static_cast<long long>(s) * reach_.HighestAtMost(L);
+        strip_widths_.push_back(s);
+        strip_values_.push_back(value);
+        best_single = std::max(best_single, static_cast<long long>(reach_.HighestAtMost(L)));
+    }
+    if (strip_widths_.empty()) return 0;
+
+    // 每块母板可容纳的最大子板面积: 以条带宽度为重量的完全背包
+    long long capacity_area;
+    if (static_cast<long long>(strip_widths_.size()) * W <= kMaxKnapsackOps) {
+        knapsack_.assign(W + 1, 0);
+        for (int c = 1; c <= W; c++) {
+            long long v = knapsack_[c - 1];
+            for (size_t t = 0; t < strip_widths_.size() && strip_widths_[t] <= c; t++) {
+                v = std::max(v, knapsack_[c - strip_widths_[t]] + strip_values_[t]);
+            }
+            knapsack_[c] = v;
+        }
+        capacity_area = knapsack_[W];
+    } else {
+        capacity_area = static_cast<long long>(W) * best_single;
+    }
+    if (capacity_area <= 0) return 0;
+    return static_cast<int>(CeilDiv(inst.Stats().total_demand_area, capacity_area));
+}
+
+// 两阶段 FFD 上界
+int BoundCalculator::ComputeUpper(const Instance& inst) {
+    if (inst.known_optimal > 0) {
+        report_.upper = inst.known_optimal;
+        return report_.upper;
+    }
+    const int W = inst.stock_width;
+    const int L = inst.stock_length;
+
+    // 子板类型按宽度降序, 同宽按长度降序
+    const int n = static_cast<int>(inst.items.size());
+    order_.resize(n);
+    for (int i = 0; i < n; i++) order_[i] = i;
+    std::sort(order_.begin(), order_.end(), [&](int a, int b) {
+        const Item& x = inst.items[a];
+        const Item& y = inst.items[b];
+        if (x.width != y.width) return x.width > y.width;
+        if (x.length != y.length) return x.length > y.length;
+        return a < b;
+    });
+
+    // 第二阶段: 子板首次适应装入条带 (条带宽度 = 开条时的子板宽度, 不小于后续子板)
+    strips_.clear();
+    for (int idx : order_) {
+        const Item& item = inst.items[idx];
+        if (item.width > W || item.length > L || item.length <= 0) {
+            report_.upper = -1;
+            return -1;
+        }
+        int remaining = item.demand;
+        for (auto& strip : strips_) {
+            if (remaining == 0) break;
+            int fit = strip.second / item.length;
+            if (fit <= 0) continue;
+            int k = std::min(fit, remaining);
+            strip.second -= k * item.length;
+            remaining -= k;
+        }
+        const int per_strip = L / item.length;
+        while (remaining > 0) {
+            int k = std::min(per_strip, remaining);
+            strips_.emplace_back(item.width, L - k * item.length);
+            remaining -= k;
+        }
+    }
+
+    // 第一阶段: 条带 (已按宽度非增) 首次适应装入母板
+    stock_free_width_.clear();
+    for (const auto& strip : strips_) {
+        bool placed = false;
+        for (int& free_width : stock_free_width_) {
+            if (free_width >= strip.first) {
+                free_width -= strip.first;
+                placed = true;
+                break;
+            }
+        }
+        if (!placed) stock_free_width_.push_back(W - strip.first);
+    }
+
+    report_.upper = static_cast<int>(stock_free_width_.size());
+    return report_.upper;
+}
@@ -0,0 +1,82 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// lower_bounds.h - 母板数的组合下界与启发式上界 (两阶段切割, 允许修边)
+// - 面积下界: ceil(总需求面积 / 母板面积)
+// - Martello-Vigo L1: 长子板 (length > L/2) 不能沿长度方向并排, 在宽度方向构成一维装箱;
+//   宽子板 (width > W/2) 同理在长度方向构成一维装箱
+// - Martello-Vigo L2: 大子板 (两边均过半) 两两不相容, 中等子板只能放入大子板剩余面积或新母板
+// - 条带背包下界: 宽度为 s 的条带至多容纳面积 s * L*(s), L*(s) 为宽度 <= s 的子板长度
+//   在 [0, L] 内可达的最大组合长度 (位集DP); 以条带类型做完全背包得到每块母板的可用面积上限
+// - 上界: 两阶段 FFD (按宽度降序组条带, 条带首次适应装入母板); 已知最优时直接取已知最优
+
+#ifndef CS_2D_DATA_LOWER_BOUNDS_H_
+#define CS_2D_DATA_LOWER_BOUNDS_H_
+
+#include "instance.h"
+#include "bitset_dp.h"
+#include <cstdint>
+#include <vector>
+
+struct BoundReport {
+    int area = 0;               // 面积下界
+    int mv_l1 = 0;              // Martello-Vigo L1 (两个方向取大)
+    int mv_l2 = 0;              // Martello-Vigo L2
+    int strip = 0;              // 条带背包下界
+    int lower = 0;              // 上述下界的最大值
+    double utilization_lb = 0.0;    // 利用率下界 = 总需求面积 / (lower * 母板面积)
+                                    // (DifficultyEstimate::utilization_lb 只用面积下界)
+    int upper = -1;             // 上界 (-1 = 未计算)
+
+    // 上界相对下界的间隙 (upper - lower) / lower; 未计算上界时为 -1
+    double GapToLowerBound() const {
+        if (upper < 0 || lower <= 0) return -1.0;
+        return static_cast<double>(upper - lower) / lower;
+    }
+};
+
+// 界计算器, 持有可复用的临时容器 (每个生成器/线程一个)
+class BoundCalculator {
+public:
+    // 计算全部下界 (覆盖上次结果, upper 重置为 -1)
+    const BoundReport& ComputeLower(const Instance& inst);
+
+    // 计算上界并写入报告的 upper 字段 (-1 = 存在放不下的子板)
+    int ComputeUpper(const Instance& inst);
+
+    const BoundReport& Report() const { return report_; }
+
+    // 条带背包的运算量上限 (条带类型数 x 母板宽度), 超过时以 W * max L*(s) 代替背包
+    static constexpr long long kMaxKnapsackOps = 1LL << 25;
+
+    // MV L2 的 (p, q) 候选数上限, 子板种类更多时均匀抽取
+    static constexpr int kMaxL2Candidates = 256;
+
+private:
+    BoundReport report_;
+
+    // 一维装箱的按尺寸计数 (下标为尺寸)
+    std::vector<long long> count_by_size_;
+    std::vector<int> nonzero_sizes_;
+    // 条带背包
+    std::vector<std::pair<int, int>> by_width_;     // (width, length) 升序
+    std::vector<int> strip_widths_;
+    std::vector<long long> strip_values_;
+    std::vector<long long> knapsack_;
+    ReachBitset reach_;
+    // 上界
+    std::vector<int> order_;
+    std::vector<std::pair<int, int>> strips_;       // (条带宽度, 剩余长度)
+    std::vector<int> stock_free_width_;
+
+    int MartelloVigoL1(const Instance& inst, bool width_dimension);
+    int MartelloVigoL2(const Instance& inst);
+    int StripKnapsackBound(const Instance& inst);
+};
+
+#endif  // CS_2D_DATA_LOWER_BOUNDS_H_
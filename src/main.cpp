@@ -11,13 +11,22 @@
 // 支持三种模式: 兼容模式(-d), 预设模式(--preset), 手动模式(--manual)
 
 #include "generator.h"
+#include "calibration_loader.h"
+#include "sweep_spec.h"
+#include "virtual_corpus.h"
+#include "corpus_summary.h"
+#include "generator_service.h"
 #include "difficulty_estimator.h"
 #include <iostream>
 #include <string>
 #include <cstring>
 #include <iomanip>
-#include <chrono>
-#include <thread>
+#include <filesystem>
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
 
 void PrintUsage(const char* program) {
     std::cout << "2D Cutting Stock Problem Instance Generator\n";
@@ -33,7 +42,8 @@ void PrintUsage(const char* program) {
     std::cout << "  -d, --difficulty <0.0-1.0>  Difficulty level (default: 0.5)\n\n";
 
     std::cout << "Manual Mode Options:\n";
-    std::cout << "  --num-types <N>             Item types (5-100, default: 20)\n";
+    std::cout << "  --num-types <N>             Item types (3-200, default: 20)\n";
+    std::cout << "  --large-scale               Allow up to 50000 item types\n";
     std::cout << "  --min-size-ratio <R>        Min item/stock area ratio (default: 0.08)\n";
     std::cout << "  --max-size-ratio <R>        Max item/stock area ratio (default: 0.35)\n";
     std::cout << "  --size-cv <V>               Size coefficient of variation (default: 0.30)\n";
@@ -47,8 +57,37 @@ void PrintUsage(const char* program) {
     std::cout << "  -n, --count <N>             Number of instances (default: 1)\n";
     std::cout << "  -W, --width <W>             Stock width (default: 200)\n";
     std::cout << "  -L, --length <L>            Stock length (default: 400)\n";
-    std::cout << "  -o, --output <dir>          Output directory (default: data)\n";
+    std::cout << "  -o, --output <dir>          Output directory (default: data; - = frame stream to stdout)\n";
+    std::cout << "  --stream-format <csv|bin>   Frame payload with -o - (default: csv)\n";
+    std::cout << "  --flush-every <N>           Flush the stream every N instances (default: 1, 0 = at end)\n";
     std::cout << "  -s, --seed <seed>           Random seed (default: 0 = timestamp)\n";
+    std::cout << "  -j, --jobs <N>              Parallel batch workers (default: 1, 0 = all cores)\n";
+    std::cout << "  --writers <N>               Batch file writer threads (default: 1)\n";
+    std::cout << "  --queue-depth <N>           Max in-flight instances between stages (default: 4 per job)\n";
+    std::cout << "  --fsync                     fsync written files (batched per writer)\n";
+    std::cout << "  --corpus <file>             Write the batch into one binary corpus file\n";
+    std::cout << "  --rescore <dir>             Re-estimate every CSV under dir (with --corpus: convert)\n";
+    std::cout << "  --cert                      Also export the packing certificate (*.cert.csv) of reverse instances\n";
+    std::cout << "  --verify <file.csv>         Check the instance's packing certificate\n";
+    std::cout << "  --sweep <spec.ini>          Generate the Cartesian product of parameter values\n";
+    std::cout << "  --manifest <file>           Also write a virtual corpus manifest of the batch\n";
+    std::cout << "  --manifest-only             Write only the manifest, generate nothing\n";
+    std::cout << "  --stats-json <file>         Write batch counters and stage timings as JSON\n";
+    std::cout << "  --summary <file>            Stream a corpus difficulty summary (batch / --rescore) to file\n";
+    std::cout << "  --merge-summaries <a,b,..>  Merge shard summaries, print the report (with --summary: save)\n";
+    std::cout << "  --dedup <index>             Skip instances whose fingerprint is in index, append new ones\n";
+    std::cout << "  --dedup-retries <n>         Regenerate a duplicate up to n times before dropping (default: 0)\n";
+    std::cout << "  --serve                     Read requests from stdin, stream instance frames to stdout\n";
+    std::cout << "  --materialize <manifest>    Regenerate instances of a manifest (default -o: temp dir)\n";
+    std::cout << "  --shard <k/n>               With --materialize: only the k-th of n contiguous shards\n";
+    std::cout << "  --range <a:b>               With --materialize: only instances a..b-1\n";
+    std::cout << "  --calibration <file>        Load estimator weights (default for --calibrate: calibration.txt)\n";
+    std::cout << "  --calibrate <results.csv>   Ingest solver results, recalibrate and save weights (repeatable)\n";
+    std::cout << "  --min-gap-to-lb <G>         Drop instances whose (greedy UB - LB) / LB < G\n";
+    std::cout << "  --index <k>                 Regenerate instance k of the batch seeded by -s\n";
+    std::cout << "  --rng <engine>              xoshiro256 (default) or mt19937 (reproduces v2.0 seeds)\n";
+    std::cout << "  --target-score <S>          Steer generation until estimated score is S\n";
+    std::cout << "  --tolerance <T>             Accepted |score - S| band (default: 0.05)\n";
     std::cout << "  -h, --help                  Show this help\n\n";
 
     std::cout << "Presets:\n";
@@ -66,6 +105,16 @@ void PrintUsage(const char* program) {
     std::cout << "Examples:\n";
     std::cout << "  " << program << " -d 0.5 -n 10                    # Legacy mode\n";
     std::cout << "  " << program << " --preset hard -n 5              # Preset mode\n";
+    std::cout << "  " << program << " --preset medium -n 10000 -j 0   # Parallel batch\n";
+    std::cout << "  " << program << " --preset medium -s 42 --index 17 # Instance 17 of seed 42\n";
+    std::cout << "  " << program << " --preset hard -n 1000 --target-score 1.4 --tolerance 0.05\n";
+    std::cout << "  " << program << " --rescore corpus -j 0               # Re-score a directory\n";
+    std::cout << "  " << program << " --sweep sweep.ini -j 0 -o sweep      # Parameter sweep\n";
+    std::cout << "  " << program << " --preset hard -n 1000000 -s 7 --manifest m.txt --manifest-only\n";
+    std::cout << "  " << program << " --materialize m.txt --shard 3/16 -j 0  # One node's shard\n";
+    std::cout << "  " << program << " --merge-summaries s0.txt,s1.txt --summary all.txt  # Combine shards\n";
+    std::cout << "  " << program << " --preset hard -n 100000 -j 0 -o - | solver --stdin\n";
+    std::cout << "  " << program << " --serve -j 4 --calibration calibration.txt  # Generator service\n";
     std::cout << "  " << program << " --manual --num-types 30 --prime-offset\n";
 }
 
@@ -85,31 +134,86 @@ void PrintEstimate(const DifficultyEstimate& est) {
     std::cout << "    需求量:    " << est.demand_contribution << "\n";
     std::cout << "    变异系数:  " << est.cv_contribution << "\n";
     std::cout << "    宽度多样性:" << est.width_div_contribution << "\n";
+    std::cout << "    条带模式:  " << est.patterns_contribution << " ("
+              << std::setprecision(0) << est.strip_patterns << " 种填充长度)\n";
 }
 
-void PrintInstanceInfo(const Instance& inst, const DifficultyEstimate& est) {
+void PrintInstanceInfo(const Instance& inst, const DifficultyEstimate& est,
+                       const BoundReport& bounds) {
+    const InstanceStats& st = inst.Stats();
     std::cout << "\n算例摘要:\n";
     std::cout << "  母板尺寸: " << inst.stock_width << " x " << inst.stock_length
-              << " (面积=" << inst.StockArea() << ")\n";
-    std::cout << "  子板类型数: " << inst.NumTypes() << "\n";
-    std::cout << "  总需求量: " << inst.TotalDemand() << "\n";
-    std::cout << "  总需求面积: " << inst.TotalDemandArea() << "\n";
+              << " (面积=" << st.StockArea() << ")\n";
+    std::cout << "  子板类型数: " << st.num_types << "\n";
+    std::cout << "  总需求量: " << st.total_demand << "\n";
+    std::cout << "  总需求面积: " << st.total_demand_area << "\n";
     std::cout << "  理论下界: " << std::fixed << std::setprecision(2)
-              << inst.TheoreticalLowerBound() << " 块母板\n";
+              << st.TheoreticalLowerBound() << " 块母板\n";
     std::cout << "  平均尺寸比: " << std::fixed << std::setprecision(2)
-              << (inst.AvgSizeRatio() * 100) << "%\n";
-    std::cout << "  尺寸变异系数: " << std::fixed << std::setprecision(3) << inst.SizeCV() << "\n";
-    std::cout << "  平均需求: " << std::fixed << std::setprecision(1) << inst.AvgDemand() << "\n";
-    std::cout << "  不同宽度数: " << inst.NumUniqueWidths()
-              << " (多样性=" << std::setprecision(2) << inst.WidthDiversity() << ")\n";
-
+              << (st.AvgSizeRatio() * 100) << "%\n";
+    std::cout << "  尺寸变异系数: " << std::fixed << std::setprecision(3) << st.SizeCV() << "\n";
+    std::cout << "  平均需求: " << std::fixed << std::setprecision(1) << st.AvgDemand() << "\n";
+    std::cout << "  不同宽度数: " << st.num_unique_widths
+              << " (多样性=" << std::setprecision(2) << st.WidthDiversity() << ")\n";
+
+    std::cout << "  母板数下界: " << bounds.lower << " (面积=" << bounds.area
+              << ", MV-L1=" << bounds.mv_l1 << ", MV-L2=" << bounds.mv_l2
+              << ", 条带背包=" << bounds.strip << ")\n";
+    std::cout << "  组合利用率下界: " << std::setprecision(1)
+              << (bounds.utilization_lb * 100) << "%\n";
     if (inst.known_optimal > 0) {
         std::cout << "  已知最优: " << inst.known_optimal << "\n";
+    } else if (bounds.upper > 0) {
+        std::cout << "  启发式上界: " << bounds.upper << " (间隙="
+                  << std::setprecision(1) << bounds.GapToLowerBound() * 100 << "%)\n";
     }
 
     PrintEstimate(est);
 }
 
+// 导入求解结果并重新校准; 特征存储与权重文件并列 (扩展名 .points)
+int RunCalibration(DifficultyEstimator& estimator, const std::string& weights_path,
+                   const std::vector<std::string>& results) {
+    std::cout << "模式: 校准 (" << weights_path << ")\n";
+    if (std::filesystem::exists(weights_path) && !estimator.LoadCalibration(weights_path)) {
+        std::cerr << "Error: Cannot load calibration " << weights_path << "\n";
+        return 1;
+    }
+
+    CalibrationStore store;
+    std::string store_path = CalibrationStore::PathFor(weights_path);
+    if (!store.Open(store_path)) return 1;
+    std::cout << "特征存储: " << store_path << " (已有 " << store.Size() << " 条)\n";
+
+    for (const auto& path : results) {
+        IngestSummary summary = CalibrationLoader::IngestResults(path, store);
+        std::cout << "  " << path << ": " << summary.rows << " 行, 新增 " << summary.added
+                  << ", 已存在 " << summary.skipped << ", 失败 " << summary.failed << "\n";
+    }
+
+    size_t num_points = store.LoadInto(estimator);
+    double rmse_before = estimator.GetPredictionRMSE();
+    double improvement = estimator.Calibrate();
+    std::cout << "校准数据点: " << num_points << ", RMSE " << std::fixed << std::setprecision(4)
+              << rmse_before << " -> " << estimator.GetPredictionRMSE()
+              << " (改进 " << improvement << ")\n";
+    if (num_points < 5) {
+        std::cout << "数据点不足 5 个, 权重未调整\n";
+    }
+
+    double w[5];
+    estimator.GetWeights(w[0], w[1], w[2], w[3], w[4]);
+    std::cout << "权重: 尺寸比=" << w[0] << " 种类数=" << w[1] << " 需求量=" << w[2]
+              << " 变异系数=" << w[3] << " 宽度多样性=" << w[4]
+              << " 条带模式=" << estimator.GetPatternWeight() << "\n";
+    if (!estimator.SaveCalibration(weights_path)) {
+        std::cerr << "Error: Cannot save calibration " << weights_path << "\n";
+        return 1;
+    }
+    std::cout << "已保存: " << weights_path << "\n";
+    return 0;
+}
+
 Preset ParsePreset(const std::string& str) {
     if (str == "easy") return Preset::kEasy;
     if (str == "medium") return Preset::kMedium;
@@ -127,6 +231,20 @@ int main(int argc, char* argv[]) {
     int count = 1;
     std::string output_dir = "data";
     int seed = 0;
+    BatchOptions batch_options;
+    long long instance_index = -1;  // >=0 时复现批内第index个算例
+    RngEngine engine = RngEngine::kXoshiro256;
+    std::string rescore_dir;    // 非空时重新评分该目录下的 CSV 算例
+    std::string verify_path;    // 非空时校验该算例的装箱证书
+    std::string merge_summaries;    // 非空时合并这些 (逗号分隔) 语料汇总文件
+    std::string sweep_path;     // 非空时按该规格文件做参数扫描
+    std::string materialize_path;   // 非空时按该虚拟语料清单重新生成
+    uint64_t shard = 0, num_shards = 0;                 // num_shards > 0 时只物化一个分片
+    uint64_t range_begin = 0, range_end = UINT64_MAX;   // 物化的序号区间
+    bool output_given = false;
+    bool serve = false;         // 常驻服务模式 (stdin 请求, stdout 帧流)
+    std::string calibration_path;               // 预估器权重文件
+    std::vector<std::string> calibrate_results; // 待导入的求解结果文件
 
     // Legacy模式参数
     double difficulty = 0.5;
@@ -179,6 +297,9 @@ int main(int argc, char* argv[]) {
         else if (arg == "--demand-skew" && i + 1 < argc) {
             params.demand_skew = std::stod(argv[++i]);
         }
+        else if (arg == "--large-scale") {
+            params.large_scale = true;
+        }
         else if (arg == "--prime-offset") {
             params.prime_offset = true;
         }
@@ -199,10 +320,124 @@ int main(int argc, char* argv[]) {
         }
         else if ((arg == "-o" || arg == "--output") && i + 1 < argc) {
             output_dir = argv[++i];
+            output_given = true;
         }
         else if ((arg == "-s" || arg == "--seed") && i + 1 < argc) {
             seed = std::stoi(argv[++i]);
         }
+        else if (arg == "--index" && i + 1 < argc) {
+            instance_index = std::stoll(argv[++i]);
+        }
+        else if (arg == "--rng" && i + 1 < argc) {
+            std::string name = argv[++i];
+            if (!ParseRngEngine(name, engine)) {
+                std::cerr << "Unknown RNG engine: " << name << "\n";
+                return 1;
+            }
+        }
+        else if (arg == "--target-score" && i + 1 < argc) {
+            batch_options.target_score = std::stod(argv[++i]);
+        }
+        else if (arg == "--tolerance" && i + 1 < argc) {
+            batch_options.target_tolerance = std::stod(argv[++i]);
+        }
+        else if ((arg == "-j" || arg == "--jobs") && i + 1 < argc) {
+            batch_options.num_jobs = std::stoi(argv[++i]);
+        }
+        else if (arg == "--writers" && i + 1 < argc) {
+            batch_options.num_writers = std::stoi(argv[++i]);
+        }
+        else if (arg == "--queue-depth" && i + 1 < argc) {
+            batch_options.queue_depth = std::stoi(argv[++i]);
+        }
+        else if (arg == "--calibration" && i + 1 < argc) {
+            calibration_path = argv[++i];
+        }
+        else if (arg == "--calibrate" && i + 1 < argc) {
+            calibrate_results.push_back(argv[++i]);
+        }
+        else if (arg == "--min-gap-to-lb" && i + 1 < argc) {
+            batch_options.min_gap_to_lb = std::stod(argv[++i]);
+        }
+        else if (arg == "--rescore" && i + 1 < argc) {
+            rescore_dir = argv[++i];
+        }
+        else if (arg == "--corpus" && i + 1 < argc) {
+            batch_options.corpus_path = argv[++i];
+        }
+        else if (arg == "--fsync") {
+            batch_options.fsync = true;
+        }
+        else if (arg == "--cert") {
+            batch_options.certificates = true;
+        }
+        else if (arg == "--verify" && i + 1 < argc) {
+            verify_path = argv[++i];
+        }
+        else if (arg == "--sweep" && i + 1 < argc) {
+            sweep_path = argv[++i];
+        }
+        else if (arg == "--manifest" && i + 1 < argc) {
+            batch_options.manifest_path = argv[++i];
+        }
+        else if (arg == "--manifest-only") {
+            batch_options.manifest_only = true;
+        }
+        else if (arg == "--stream-format" && i + 1 < argc) {
+            std::string format = argv[++i];
+            if (format == "csv") batch_options.stream_payload = StreamPayload::kCsv;
+            else if (format == "bin") batch_options.stream_payload = StreamPayload::kBinary;
+            else {
+                std::cerr << "Unknown stream format: " << format << "\n";
+                return 1;
+            }
+        }
+        else if (arg == "--flush-every" && i + 1 < argc) {
+            batch_options.flush_every = std::stoi(argv[++i]);
+        }
+        else if (arg == "--summary" && i + 1 < argc) {
+            batch_options.summary_path = argv[++i];
+        }
+        else if (arg == "--merge-summaries" && i + 1 < argc) {
+            merge_summaries = argv[++i];
+        }
+        else if (arg == "--stats-json" && i + 1 < argc) {
+            batch_options.stats_json_path = argv[++i];
+        }
+        else if (arg == "--dedup" && i + 1 < argc) {
+            batch_options.fingerprint_index = argv[++i];
+        }
+        else if (arg == "--dedup-retries" && i + 1 < argc) {
+            batch_options.dedup_retries = std::stoi(argv[++i]);
+        }
+        else if (arg == "--serve") {
+            serve = true;
+        }
+        else if (arg == "--materialize" && i + 1 < argc) {
+            materialize_path = argv[++i];
+        }
+        else if (arg == "--shard" && i + 1 < argc) {
+            std::string value = argv[++i];
+            unsigned long long k = 0, n = 0;
+            char tail = 0;
+            if (std::sscanf(value.c_str(), "%llu/%llu%c", &k, &n, &tail) != 2 || n == 0 || k >= n) {
+                std::cerr << "Error: --shard expects k/n with 0 <= k < n\n";
+                return 1;
+            }
+            shard = k;
+            num_shards = n;
+        }
+        else if (arg == "--range" && i + 1 < argc) {
+            std::string value = argv[++i];
+            unsigned long long a = 0, b = 0;
+            char tail = 0;
+            if (std::sscanf(value.c_str(), "%llu:%llu%c", &a, &b, &tail) != 2 || a >= b) {
+                std::cerr << "Error: --range expects a:b with a < b\n";
+                return 1;
+            }
+            range_begin = a;
+            range_end = b;
+        }
         else {
             std::cerr << "Unknown option: " << arg << "\n";
             PrintUsage(argv[0]);
@@ -215,53 +450,173 @@ int main(int argc, char* argv[]) {
         std::cerr << "Error: Count must be at least 1\n";
         return 1;
     }
+    if (instance_index >= 0 && (seed == 0 || count != 1)) {
+        std::cerr << "Error: --index requires a nonzero --seed and a single instance\n";
+        return 1;
+    }
+    if (instance_index >= 0 && (!batch_options.corpus_path.empty() ||
+                                !batch_options.manifest_path.empty())) {
+        std::cerr << "Error: --index cannot be combined with --corpus or --manifest\n";
+        return 1;
+    }
+    if (batch_options.certificates && !batch_options.corpus_path.empty()) {
+        std::cerr << "Error: --cert cannot be combined with --corpus\n";
+        return 1;
+    }
+    const bool to_stdout = output_dir == "-";
+    if (to_stdout && (batch_options.certificates || !batch_options.corpus_path.empty() ||
+                      !sweep_path.empty() || !rescore_dir.empty())) {
+        std::cerr << "Error: -o - cannot be combined with --cert, --corpus, --sweep or --rescore\n";
+        return 1;
+    }
+    if (batch_options.manifest_only && batch_options.manifest_path.empty()) {
+        std::cerr << "Error: --manifest-only requires --manifest\n";
+        return 1;
+    }
+    // 去重结果取决于索引内容与完成顺序, 清单无法复现
+    if (!batch_options.fingerprint_index.empty() &&
+        (!batch_options.manifest_path.empty() || !materialize_path.empty())) {
+        std::cerr << "Error: --dedup cannot be combined with --manifest or --materialize\n";
+        return 1;
+    }
+    if ((num_shards > 0 || range_end != UINT64_MAX) && materialize_path.empty()) {
+        std::cerr << "Error: --shard and --range require --materialize\n";
+        return 1;
+    }
+
+    // stdout 用于帧流时, 提示信息改写到 stderr
+    if (serve || to_stdout) {
+        std::cout.rdbuf(std::cerr.rdbuf());
+        SetBinaryMode(stdout);
+        IgnoreBrokenPipe();     // 下游提前关闭时照常收尾 (END 帧写出失败, 统计仍打印)
+    }
+    if (to_stdout) {
+        batch_options.stream = stdout;
+    }
 
     std::cout << "二维下料问题算例生成器 v2.0\n";
     std::cout << "===========================\n";
 
+    if (!verify_path.empty()) {
+        return InstanceGenerator::VerifyCertificateFile(verify_path) ? 0 : 1;
+    }
+
+    // 合并各分片的语料汇总
+    if (!merge_summaries.empty()) {
+        CorpusSummary merged;
+        size_t begin = 0;
+        int num_files = 0;
+        while (begin <= merge_summaries.size()) {
+            size_t end = merge_summaries.find(',', begin);
+            if (end == std::string::npos) end = merge_summaries.size();
+            std::string path = merge_summaries.substr(begin, end - begin);
+            begin = end + 1;
+            if (path.empty()) continue;
+            CorpusSummary part;
+            if (!part.Load(path)) {
+                std::cerr << "Error: " << path << ": " << part.Error() << "\n";
+                return 1;
+            }
+            if (!merged.Merge(part)) {
+                std::cerr << "Error: " << path << ": " << merged.Error() << "\n";
+                return 1;
+            }
+            num_files++;
+        }
+        std::cout << "模式: 合并语料汇总 (" << num_files << " 个文件)\n";
+        merged.Print(std::cout);
+        if (!batch_options.summary_path.empty()) {
+            if (!merged.Save(batch_options.summary_path)) return 1;
+            std::cout << "语料汇总: " << batch_options.summary_path << std::endl;
+        }
+        return 0;
+    }
+
     // 创建生成器
-    InstanceGenerator generator(seed);
+    InstanceGenerator generator(seed, engine);
 
-    // 根据模式生成
-    GenerationResult result;
+    // 校准模式: 导入求解结果, 重新拟合并保存权重
+    if (!calibrate_results.empty()) {
+        if (calibration_path.empty()) calibration_path = "calibration.txt";
+        return RunCalibration(generator.GetEstimator(), calibration_path, calibrate_results);
+    }
+    if (!calibration_path.empty()) {
+        if (!generator.GetEstimator().LoadCalibration(calibration_path)) {
+            std::cerr << "Error: Cannot load calibration " << calibration_path << "\n";
+            return 1;
+        }
+        std::cout << "已加载校准权重: " << calibration_path << "\n";
+    }
+
+    if (!rescore_dir.empty()) {
+        std::cout << "模式: 重新评分 (" << rescore_dir << ")\n";
+        generator.RescoreDirectory(rescore_dir, batch_options);
+        return 0;
+    }
+
+    if (serve) {
+        GeneratorService service(batch_options.num_jobs, engine, generator.GetEstimator());
+        std::cout << "模式: 生成服务 (" << service.NumWorkers() << " 个生成器, 每行一个请求)"
+                  << std::endl;
+        FrameWriter writer(stdout);
+        return service.Run(std::cin, writer) ? 0 : 1;
+    }
+
+    if (!materialize_path.empty()) {
+        VirtualCorpus corpus;
+        if (!corpus.Load(materialize_path)) {
+            std::cerr << "Error: " << materialize_path << ": " << corpus.Error() << "\n";
+            return 1;
+        }
+        uint64_t begin = 0, end = corpus.count;
+        if (num_shards > 0) corpus.ShardRange(shard, num_shards, begin, end);
+        begin = std::max(begin, range_begin);
+        end = std::min(end, range_end);
+        if (begin >= end) {
+            std::cerr << "Error: empty range (manifest has " << corpus.count << " instances)\n";
+            return 1;
+        }
+        if (end - begin > static_cast<uint64_t>(INT_MAX)) {
+            std::cerr << "Error: range too large, use --shard or --range\n";
+            return 1;
+        }
+        // 未指定 -o 时物化到本机临时目录
+        if (!output_given) {
+            output_dir = (std::filesystem::temp_directory_path() /
+                ("cs2d_" + std::to_string(corpus.params.seed) + "_" + std::to_string(begin))).string();
+        }
+        std::cout << "模式: 物化虚拟语料 (" << materialize_path << ", 序号 " << begin << ".."
+                  << end - 1 << " / " << corpus.count << ")\n";
+
+        // 引擎与权重以清单为准, 与原批次一致
+        InstanceGenerator materializer(seed, corpus.engine);
+        corpus.ApplyTo(materializer.GetEstimator());
+        BatchOptions options = corpus.ApplyTo(batch_options);
+        options.first_index = begin;
+        options.manifest_path.clear();
+        options.manifest_only = false;
+        materializer.GenerateBatch(corpus.params, static_cast<int>(end - begin), output_dir, options);
+        return 0;
+    }
+
+    if (!sweep_path.empty()) {
+        SweepSpec spec;
+        if (!spec.Load(sweep_path)) {
+            std::cerr << "Error: " << sweep_path << ": " << spec.Error() << "\n";
+            return 1;
+        }
+        std::cout << "模式: 参数扫描 (" << sweep_path << ")\n";
+        return generator.GenerateSweep(spec, output_dir, seed, batch_options) ? 0 : 1;
+    }
+
+    // 根据模式确定生成参数
+    GeneratorParams run_params;
 
     switch (mode) {
         case Mode::kLegacy: {
             std::cout << "模式: 兼容模式 (difficulty=" << difficulty << ")\n";
-            if (count == 1) {
-                result = generator.GenerateLegacy(difficulty,
-                    params.stock_width, params.stock_length);
-                if (result.success) {
-                    PrintInstanceInfo(result.instance, result.estimate);
-                    std::string filepath = InstanceGenerator::GenerateFilename(
-                        params, output_dir, result.estimate.score);
-                    if (InstanceGenerator::ExportCSV(result.instance, filepath)) {
-                        std::cout << "\n已导出: " << filepath << "\n";
-                    }
-                } else {
-                    std::cerr << "错误: " << result.error_message << "\n";
-                    return 1;
-                }
-            } else {
-                // 批量: 使用旧参数映射
-                for (int i = 0; i < count; i++) {
-                    result = generator.GenerateLegacy(difficulty,
-                        params.stock_width, params.stock_length);
-                    if (result.success) {
-                        std::string filepath = InstanceGenerator::GenerateFilename(
-                            params, output_dir, result.estimate.score);
-                        InstanceGenerator::ExportCSV(result.instance, filepath);
-                        std::cout << "已生成: " << filepath
-                                  << " (" << result.estimate.level_name
-                                  << ", 得分=" << std::fixed << std::setprecision(2)
-                                  << result.estimate.score << ")\n";
-                    }
-                    if (i < count - 1) {
-                        std::this_thread::sleep_for(std::chrono::seconds(1));
-                    }
-                }
-                std::cout << "\n已在 " << output_dir << " 生成 " << count << " 个算例\n";
-            }
+            run_params = GeneratorParams::FromLegacy(
+                difficulty, params.stock_width, params.stock_length);
             break;
         }
 
@@ -275,60 +630,78 @@ int main(int argc, char* argv[]) {
             }
             std::cout << "模式: 预设模式 (" << preset_name << ")\n";
 
-            GeneratorParams preset_params = GeneratorParams::FromPreset(preset);
-            preset_params.stock_width = params.stock_width;
-            preset_params.stock_length = params.stock_length;
-            preset_params.seed = seed;
-
-            if (count == 1) {
-                result = generator.Generate(preset_params);
-                if (result.success) {
-                    PrintInstanceInfo(result.instance, result.estimate);
-                    std::string filepath = InstanceGenerator::GenerateFilename(
-                        preset_params, output_dir, result.estimate.score);
-                    if (InstanceGenerator::ExportCSV(result.instance, filepath)) {
-                        std::cout << "\n已导出: " << filepath << "\n";
-                    }
-                } else {
-                    std::cerr << "错误: " << result.error_message << "\n";
-                    return 1;
-                }
-            } else {
-                generator.GenerateBatch(preset_params, count, output_dir);
-            }
+            run_params = GeneratorParams::FromPreset(preset);
+            run_params.stock_width = params.stock_width;
+            run_params.stock_length = params.stock_length;
             break;
         }
 
         case Mode::kManual: {
             std::cout << "模式: 手动模式\n";
-            params.seed = seed;
-
             std::cout << params.GetSummary();
 
             if (!params.Validate()) {
                 std::cerr << "错误: 参数无效\n";
                 return 1;
             }
-
-            if (count == 1) {
-                result = generator.Generate(params);
-                if (result.success) {
-                    PrintInstanceInfo(result.instance, result.estimate);
-                    std::string filepath = InstanceGenerator::GenerateFilename(
-                        params, output_dir, result.estimate.score);
-                    if (InstanceGenerator::ExportCSV(result.instance, filepath)) {
-                        std::cout << "\n已导出: " << filepath << "\n";
-                    }
-                } else {
-                    std::cerr << "错误: " << result.error_message << "\n";
-                    return 1;
-                }
-            } else {
-                generator.GenerateBatch(params, count, output_dir);
-            }
+            run_params = params;
             break;
         }
     }
+    run_params.seed = seed;
+
+    if (count > 1 || !batch_options.corpus_path.empty() || !batch_options.manifest_path.empty() ||
+        !batch_options.fingerprint_index.empty() || to_stdout) {
+        if (instance_index >= 0) {
+            batch_options.first_index = static_cast<uint64_t>(instance_index);
+        }
+        generator.GenerateBatch(run_params, count, output_dir, batch_options);
+        return 0;
+    }
+
+    // 单个算例 (指定 --index 时复现批内第index个算例)
+    GenerationResult result;
+    bool targeted = batch_options.target_score >= 0.0;
+    if (targeted) {
+        result = (instance_index >= 0)
+            ? generator.GenerateTargeted(run_params, static_cast<uint64_t>(instance_index),
+                  batch_options.target_score, batch_options.target_tolerance)
+            : generator.GenerateTargeted(run_params, batch_options.target_score,
+                  batch_options.target_tolerance);
+        std::cout << "目标难度: " << batch_options.target_score << " ± "
+                  << batch_options.target_tolerance << ", 迭代 " << result.iterations
+                  << " 次, 用时 " << std::fixed << std::setprecision(2)
+                  << result.elapsed_ms << " ms\n";
+    } else if (instance_index >= 0) {
+        result = generator.Generate(run_params, static_cast<uint64_t>(instance_index));
+    } else {
+        result = generator.Generate(run_params);
+    }
+    if (!result.success) {
+        std::cerr << "错误: " << result.error_message << "\n";
+        return 1;
+    }
+
+    generator.ComputeUpperBound(result);
+    PrintInstanceInfo(result.instance, result.estimate, result.bounds);
+    double gap = result.bounds.GapToLowerBound();
+    if (batch_options.min_gap_to_lb >= 0.0 && gap >= 0.0 && gap < batch_options.min_gap_to_lb) {
+        std::cout << "\n算例可证明容易 (上界-下界间隙 < " << batch_options.min_gap_to_lb
+                  << "), 未导出\n";
+        return 0;
+    }
+    std::string filepath = (instance_index >= 0)
+        ? InstanceGenerator::GenerateFilename(run_params, output_dir,
+                                              result.estimate.score, instance_index)
+        : InstanceGenerator::GenerateFilename(run_params, output_dir,
+                                              result.estimate.score);
+    if (InstanceGenerator::ExportCSV(result.instance, filepath)) {
+        std::cout << "\n已导出: " << filepath << "\n";
+        if (batch_options.certificates &&
+            InstanceGenerator::ExportCertificate(result.instance, filepath)) {
+            std::cout << "已导出证书: " << CertificatePath(filepath) << "\n";
+        }
+    }
 
     return 0;
 }
@@ -0,0 +1,184 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// rng.h - 随机数工具
+// 计数器式种子派生: 第k个算例的随机流只由 (基础种子, k) 决定
+// 可选随机数引擎: xoshiro256** (默认, 32字节状态) / mt19937 (兼容旧种子)
+
+#ifndef CS_2D_DATA_RNG_H_
+#define CS_2D_DATA_RNG_H_
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+
+// SplitMix64 混合函数 (Steele et al.), 用作种子派生的雪崩映射
+inline uint64_t SplitMix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// 派生第index个算例的独立种子
+// O(1) 计算, 与生成顺序和线程调度无关
+inline uint64_t DeriveInstanceSeed(uint64_t base_seed, uint64_t index) {
+    return SplitMix64(SplitMix64(base_seed) + (index + 1) * 0x9E3779B97F4A7C15ULL);
+}
+
+// 第index个算例第attempt次重抽 (去重重新生成) 的子流种子; attempt = 0 即 DeriveInstanceSeed
+inline uint64_t DeriveAttemptSeed(uint64_t base_seed, uint64_t index, uint32_t attempt) {
+    uint64_t seed = DeriveInstanceSeed(base_seed, index);
+    return attempt == 0 ? seed : SplitMix64(seed ^ (attempt * 0xD1B54A32D192ED03ULL));
+}
+
+// 双字种子序列, 按标准 std::seed_seq::generate 算法实现, 但不分配堆内存
+// (用于以64位派生种子初始化 mt19937, 结果与 std::seed_seq{lo, hi} 一致)
+class SeedSeq2 {
+public:
+    using result_type = uint32_t;
+
+    explicit SeedSeq2(uint64_t seed_value)
+        : v_{static_cast<uint32_t>(seed_value), static_cast<uint32_t>(seed_value >> 32)} {}
+
+    size_t size() const { return 2; }
+
+    template <typename It>
+    void generate(It begin, It end) const {
+        const size_t n = static_cast<size_t>(end - begin);
+        if (n == 0) return;
+        for (It it = begin; it != end; ++it) *it = 0x8b8b8b8bu;
+
+        const size_t s = 2;
+        const size_t t = (n >= 623) ? 11 : (n >= 68) ? 7 : (n >= 39) ? 5
+                       : (n >= 7) ? 3 : (n - 1) / 2;
+        const size_t p = (n - t) / 2;
+        const size_t q = p + t;
+        const size_t m = (s + 1 > n) ? s + 1 : n;
+        auto at = [&](size_t k) -> uint32_t& { return begin[k % n]; };
+        auto tmix = [](uint32_t x) { return x ^ (x >> 27); };
+
+        for (size_t k = 0; k < m; k++) {
+            uint32_t r1 = 1664525u * tmix(at(k) ^ at(k + p) ^ at(k + n - 1));
+            uint32_t r2 = r1 + static_cast<uint32_t>(
+                k == 0 ? s : (k <= s ? k % n + v_[k - 1] : k % n));
+            at(k + p) += r1;
+            at(k + q) += r2;
+            at(k) = r2;
+        }
+        for (size_t k = m; k < m + n; k++) {
+            uint32_t r3 = 1566083941u * tmix(at(k) + at(k + p) + at(k + n - 1));
+            uint32_t r4 = r3 - static_cast<uint32_t>(k % n);
+            at(k + p) ^= r3;
+            at(k + q) ^= r4;
+            at(k) = r4;
+        }
+    }
+
+private:
+    uint32_t v_[2];
+};
+
+// 随机数引擎选择
+enum class RngEngine {
+    kXoshiro256,    // xoshiro256** 高吞吐默认引擎
+    kMt19937        // std::mt19937 兼容模式 (与旧版本同种子输出一致)
+};
+
+// 引擎名称 <-> 枚举
+inline const char* RngEngineName(RngEngine engine) {
+    return engine == RngEngine::kMt19937 ? "mt19937" : "xoshiro256";
+}
+
+inline bool ParseRngEngine(const std::string& name, RngEngine& engine) {
+    if (name == "xoshiro256" || name == "xoshiro") {
+        engine = RngEngine::kXoshiro256;
+        return true;
+    }
+    if (name == "mt19937" || name == "mt") {
+        engine = RngEngine::kMt19937;
+        return true;
+    }
+    return false;
+}
+
+// xoshiro256** (Blackman & Vigna), 满足 UniformRandomBitGenerator
+class Xoshiro256StarStar {
+public:
+    using result_type = uint64_t;
+
+    explicit Xoshiro256StarStar(uint64_t seed_value = 1) { seed(seed_value); }
+
+    // 以 SplitMix64 序列展开64位种子, 避免全零状态
+    void seed(uint64_t seed_value) {
+        uint64_t x = seed_value;
+        for (auto& word : s_) {
+            word = SplitMix64(x);
+            x += 0x9E3779B97F4A7C15ULL;
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<uint64_t>::max(); }
+
+    result_type operator()() {
+        const uint64_t result = Rotl(s_[1] * 5, 7) * 9;
+        const uint64_t t = s_[1] << 17;
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = Rotl(s_[3], 45);
+        return result;
+    }
+
+private:
+    uint64_t s_[4];
+
+    static uint64_t Rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+// 闭区间 [lo, hi] 均匀整数
+// 通用版本 (64位输出引擎): Lemire 乘法取高位法, 平均几乎不需要除法
+template <typename Engine>
+inline int UniformInt(Engine& rng, int lo, int hi) {
+    static_assert(Engine::max() == std::numeric_limits<uint64_t>::max(),
+                  "UniformInt requires a 64-bit engine");
+    const uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(hi) - lo) + 1;
+    uint64_t m = (rng() >> 32) * range;
+    uint32_t low = static_cast<uint32_t>(m);
+    if (low < range) {
+        const uint32_t threshold = static_cast<uint32_t>((0x100000000ULL - range) % range);
+        while (low < threshold) {
+            m = (rng() >> 32) * range;
+            low = static_cast<uint32_t>(m);
+        }
+    }
+    return lo + static_cast<int>(m >> 32);
+}
+
+// mt19937 兼容版本: 保持标准分布的抽样序列
+inline int UniformInt(std::mt19937& rng, int lo, int hi) {
+    std::uniform_int_distribution<int> dist(lo, hi);
+    return dist(rng);
+}
+
+// [0, 1) 均匀实数
+template <typename Engine>
+inline double UniformReal(Engine& rng) {
+    return static_cast<double>(rng() >> 11) * 0x1.0p-53;
+}
+
+inline double UniformReal(std::mt19937& rng) {
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    return dist(rng);
+}
+
+#endif  // CS_2D_DATA_RNG_H_
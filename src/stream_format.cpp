@@ -0,0 +1,104 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// stream_format.cpp - 算例帧流写出实现
+
+#include "stream_format.h"
+#include "corpus_writer.h"
+#include "csv_io.h"
+#include <csignal>
+#include <cstring>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+FrameWriter::FrameWriter(std::FILE* out, int flush_every)
+    : out_(out), flush_every_(flush_every) {}
+
+bool FrameWriter::WriteHeader() {
+    StreamHeader header{};
+    std::memcpy(header.magic, kStreamMagic, sizeof(kStreamMagic));
+    header.version = kStreamVersion;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (std::fwrite(&header, sizeof(header), 1, out_) != 1 || std::fflush(out_) != 0) {
+        failed_ = true;
+    }
+    return !failed_;
+}
+
+bool FrameWriter::Write(const char tag[4], uint64_t index, const void* data, size_t size) {
+    StreamFrameHeader frame{};
+    std::memcpy(frame.tag, tag, sizeof(frame.tag));
+    frame.size = static_cast<uint32_t>(size);
+    frame.index = index;
+    const bool always_flush = std::memcmp(tag, kFrameEnd, 4) == 0 ||
+                              std::memcmp(tag, kFrameError, 4) == 0;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (failed_) return false;
+    if (std::fwrite(&frame, sizeof(frame), 1, out_) != 1 ||
+        (size > 0 && std::fwrite(data, 1, size, out_) != size)) {
+        failed_ = true;
+        return false;
+    }
+    // 按帧数刷新, 消费方可在后续算例仍在生成时开始处理已到达的算例
+    unflushed_++;
+    if (always_flush || (flush_every_ > 0 && unflushed_ >= flush_every_)) {
+        unflushed_ = 0;
+        if (std::fflush(out_) != 0) failed_ = true;
+    }
+    return !failed_;
+}
+
+bool FrameWriter::WriteInstance(StreamPayload payload, uint64_t index, const Instance& inst,
+                                double score) {
+    if (payload == StreamPayload::kBinary) {
+        thread_local std::vector<unsigned char> record;
+        EncodeCorpusRecord(index, inst, score, record);
+        return Write(kFrameBinary, index, record.data(), record.size());
+    }
+    thread_local CsvSerializer serializer;
+    const std::string& text = serializer.Format(inst);
+    return Write(kFrameCsv, index, text.data(), text.size());
+}
+
+bool FrameWriter::WriteEnd(uint64_t delivered, const std::string& summary) {
+    return Write(kFrameEnd, delivered, summary.data(), summary.size());
+}
+
+bool FrameWriter::WriteError(const std::string& message) {
+    return Write(kFrameError, 0, message.data(), message.size());
+}
+
+bool FrameWriter::WriteFailure(uint64_t index, const std::string& reason) {
+    return Write(kFrameFailed, index, reason.data(), reason.size());
+}
+
+bool FrameWriter::Flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    unflushed_ = 0;
+    if (std::fflush(out_) != 0) failed_ = true;
+    return !failed_;
+}
+
+void SetBinaryMode(std::FILE* file) {
+#ifdef _WIN32
+    _setmode(_fileno(file), _O_BINARY);
+#else
+    (void)file;
+#endif
+}
+
+void IgnoreBrokenPipe() {
+#ifndef _WIN32
+    std::signal(SIGPIPE, SIG_IGN);
+#endif
+}
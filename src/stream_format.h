@@ -0,0 +1,104 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// stream_format.h - 算例帧流格式 (服务模式与管道输出)
+//
+// 流布局 (小端):
+//   StreamHeader                    (16 字节, 流开始时写一次)
+//   帧 0..k: StreamFrameHeader (16 字节) + payload[size]
+//
+// 帧类型:
+//   "CSV " 一个算例的 CSV 文本 (与导出文件内容相同), index = 批内序号
+//   "BIN " 一条二进制语料记录 (CorpusRecord + SoA 列, 见 corpus.h), index = 批内序号
+//   "END " 一次请求 (或整个批次) 结束, index = 交付的算例数, payload = "key=value ..." 摘要
+//   "FAIL" 单个算例生成失败或被筛除, index = 批内序号, payload = 原因 (请求仍以 END 结束)
+//   "ERR " 请求无效 (其后没有 END 帧), index = 0, payload = 错误信息
+// 算例帧可能乱序到达 (多线程生成), 以 index 为准
+
+#ifndef CS_2D_DATA_STREAM_FORMAT_H_
+#define CS_2D_DATA_STREAM_FORMAT_H_
+
+#include "instance.h"
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+constexpr char kStreamMagic[8] = {'C', 'S', '2', 'D', 'S', 'T', 'R', 'M'};
+constexpr uint32_t kStreamVersion = 1;
+
+struct StreamHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+};
+
+struct StreamFrameHeader {
+    char tag[4];
+    uint32_t size;                  // payload 字节数
+    uint64_t index;
+};
+
+static_assert(sizeof(StreamHeader) == 16, "StreamHeader layout");
+static_assert(sizeof(StreamFrameHeader) == 16, "StreamFrameHeader layout");
+
+constexpr char kFrameCsv[4] = {'C', 'S', 'V', ' '};
+constexpr char kFrameBinary[4] = {'B', 'I', 'N', ' '};
+constexpr char kFrameEnd[4] = {'E', 'N', 'D', ' '};
+constexpr char kFrameError[4] = {'E', 'R', 'R', ' '};
+constexpr char kFrameFailed[4] = {'F', 'A', 'I', 'L'};
+
+enum class StreamPayload { kCsv, kBinary };
+
+// 帧写出器 (线程安全): 每帧整体写出, 多线程交错时帧不会被拆开
+class FrameWriter {
+public:
+    // flush_every: 每写出这么多个帧刷新一次 (0 = 只在 Flush 或 END 帧时刷新)
+    explicit FrameWriter(std::FILE* out, int flush_every = 1);
+
+    FrameWriter(const FrameWriter&) = delete;
+    FrameWriter& operator=(const FrameWriter&) = delete;
+
+    // 写流头
+    bool WriteHeader();
+
+    // 写一个帧
+    bool Write(const char tag[4], uint64_t index, const void* data, size_t size);
+
+    // 写一个算例帧 (按 payload 格式编码, 每线程复用编码缓冲区)
+    bool WriteInstance(StreamPayload payload, uint64_t index, const Instance& inst,
+                       double score);
+
+    // 写 END / ERR 帧 (总是刷新)
+    bool WriteEnd(uint64_t delivered, const std::string& summary);
+    bool WriteError(const std::string& message);
+
+    // 写一个算例失败帧 (index = 批内序号)
+    bool WriteFailure(uint64_t index, const std::string& reason);
+
+    bool Flush();
+
+    // 写出失败 (如下游关闭管道) 后为 true
+    bool Failed() const { return failed_; }
+
+private:
+    std::mutex mutex_;
+    std::FILE* out_;
+    int flush_every_;
+    int unflushed_ = 0;
+    bool failed_ = false;
+};
+
+// 将标准流设为二进制模式 (Windows 下避免 \n 被转换为 \r\n)
+void SetBinaryMode(std::FILE* file);
+
+// 下游关闭管道时不终止进程 (POSIX 下忽略 SIGPIPE): 写出改为返回失败, 由调用方收尾
+void IgnoreBrokenPipe();
+
+#endif  // CS_2D_DATA_STREAM_FORMAT_H_
@@ -0,0 +1,42 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// strip_patterns.cpp - 第二阶段条带填充模式计数实现
+
+#include "strip_patterns.h"
+#include <algorithm>
+
+double StripPatternCounter::Count(const Instance& inst) {
+    const int W = inst.stock_width;
+    const int L = inst.stock_length;
+    if (L <= 0 || inst.items.empty()) return 0.0;
+
+    by_width_.clear();
+    for (const auto& item : inst.items) {
+        by_width_.emplace_back(item.width, item.length);
+    }
+    std::sort(by_width_.begin(), by_width_.end());
+
+    reach_.Reset(L);
+    bool full = false;
+    double total = 0.0;
+    int reachable = 1;
+    for (size_t i = 0; i < by_width_.size();) {
+        const int s = by_width_[i].first;
+        if (s > W) break;
+        for (; i < by_width_.size() && by_width_[i].first == s; i++) {
+            // 提前截止: 位集已满, 或该长度已是已有长度之和 (加入不扩大可达集合)
+            if (full || reach_.Test(by_width_[i].second)) continue;
+            reach_.AddUnbounded(by_width_[i].second);
+            reachable = reach_.Count();
+            full = reachable == L + 1;
+        }
+        total += reachable - 1;
+    }
+    return total;
+}
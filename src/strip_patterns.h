@@ -0,0 +1,32 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// strip_patterns.h - 第二阶段条带填充模式计数
+// 对每个不同宽度 s, 宽度 <= s 的子板长度在 [0, L] 内的可达组合长度数即该条带
+// 可行填充的不同长度数 (每个长度至少对应一种模式, 也是定价子问题背包DP的状态数);
+// 按宽度升序增量维护同一位集, 位集填满后其余宽度直接计 L, 不再做DP
+
+#ifndef CS_2D_DATA_STRIP_PATTERNS_H_
+#define CS_2D_DATA_STRIP_PATTERNS_H_
+
+#include "instance.h"
+#include "bitset_dp.h"
+#include <utility>
+#include <vector>
+
+class StripPatternCounter {
+public:
+    // 所有条带宽度的不同非空填充长度数之和
+    double Count(const Instance& inst);
+
+private:
+    ReachBitset reach_;
+    std::vector<std::pair<int, int>> by_width_;     // (width, length) 升序
+};
+
+#endif  // CS_2D_DATA_STRIP_PATTERNS_H_
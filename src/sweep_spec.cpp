@@ -0,0 +1,161 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// sweep_spec.cpp - 参数扫描规格解析实现
+
+#include "sweep_spec.h"
+#include <cstdlib>
+#include <fstream>
+#include <utility>
+
+namespace {
+
+std::string Trim(const std::string& s) {
+    size_t b = s.find_first_not_of(" \t\r");
+    if (b == std::string::npos) return std::string();
+    size_t e = s.find_last_not_of(" \t\r");
+    return s.substr(b, e - b + 1);
+}
+
+// "preset" 覆盖其余参数, 总是最先应用
+void ApplyInOrder(GeneratorParams& params,
+                  const std::vector<std::pair<std::string, std::string>>& values) {
+    for (const auto& kv : values) {
+        if (kv.first == "preset") params.Set(kv.first, kv.second);
+    }
+    for (const auto& kv : values) {
+        if (kv.first != "preset") params.Set(kv.first, kv.second);
+    }
+}
+
+}  // namespace
+
+bool SweepSpec::Load(const std::string& filepath) {
+    base_ = GeneratorParams();
+    axes_.clear();
+    count_ = 1;
+    error_.clear();
+
+    std::ifstream file(filepath);
+    if (!file.is_open()) {
+        error_ = "cannot open file";
+        return false;
+    }
+
+    enum class Section { kNone, kBase, kSweep, kRun };
+    Section section = Section::kNone;
+    std::vector<std::pair<std::string, std::string>> base_values;
+    std::string line;
+    int line_no = 0;
+    auto fail = [&](const std::string& message) {
+        error_ = "line " + std::to_string(line_no) + ": " + message;
+        return false;
+    };
+
+    while (std::getline(file, line)) {
+        line_no++;
+        size_t comment = line.find_first_of("#;");
+        std::string text = Trim(comment == std::string::npos ? line : line.substr(0, comment));
+        if (text.empty()) continue;
+
+        if (text.front() == '[') {
+            if (text.back() != ']') return fail("bad section header");
+            std::string name = Trim(text.substr(1, text.size() - 2));
+            if (name == "base") section = Section::kBase;
+            else if (name == "sweep") section = Section::kSweep;
+            else if (name == "run") section = Section::kRun;
+            else return fail("unknown section [" + name + "]");
+            continue;
+        }
+
+        size_t eq = text.find('=');
+        if (eq == std::string::npos) return fail("expected key = value");
+        std::string key = Trim(text.substr(0, eq));
+        std::string value = Trim(text.substr(eq + 1));
+        GeneratorParams probe;
+
+        switch (section) {
+            case Section::kBase:
+                if (!probe.Set(key, value)) return fail("bad parameter " + key + " = " + value);
+                base_values.emplace_back(key, value);
+                break;
+
+            case Section::kSweep: {
+                SweepAxis axis;
+                axis.key = key;
+                size_t start = 0;
+                for (;;) {
+                    size_t comma = value.find(',', start);
+                    std::string v = Trim(value.substr(start, comma - start));
+                    if (!probe.Set(key, v)) return fail("bad value " + key + " = " + v);
+                    axis.values.push_back(v);
+                    if (comma == std::string::npos) break;
+                    start = comma + 1;
+                }
+                for (const auto& other : axes_) {
+                    if (other.key == key) return fail("duplicate sweep key " + key);
+                }
+                axes_.push_back(std::move(axis));
+                break;
+            }
+
+            case Section::kRun:
+                if (key == "count") {
+                    char* end = nullptr;
+                    long v = std::strtol(value.c_str(), &end, 10);
+                    if (value.empty() || *end != '\0' || v < 1 || v > 100000000) {
+                        return fail("bad count " + value);
+                    }
+                    count_ = static_cast<int>(v);
+                } else {
+                    return fail("unknown run key " + key);
+                }
+                break;
+
+            case Section::kNone:
+                return fail("key outside of a section");
+        }
+    }
+
+    ApplyInOrder(base_, base_values);
+    return true;
+}
+
+size_t SweepSpec::NumCells() const {
+    size_t n = 1;
+    for (const auto& axis : axes_) n *= axis.values.size();
+    return n;
+}
+
+size_t SweepSpec::ValueIndex(size_t cell, size_t axis) const {
+    // 混合进制分解, 最后一维为最低位
+    for (size_t a = axes_.size(); a-- > axis + 1;) {
+        cell /= axes_[a].values.size();
+    }
+    return cell % axes_[axis].values.size();
+}
+
+GeneratorParams SweepSpec::CellParams(size_t cell) const {
+    std::vector<std::pair<std::string, std::string>> values;
+    values.reserve(axes_.size());
+    for (size_t a = 0; a < axes_.size(); a++) {
+        values.emplace_back(axes_[a].key, axes_[a].values[ValueIndex(cell, a)]);
+    }
+    GeneratorParams params = base_;
+    ApplyInOrder(params, values);
+    return params;
+}
+
+std::string SweepSpec::CellLabel(size_t cell) const {
+    std::string label;
+    for (size_t a = 0; a < axes_.size(); a++) {
+        if (a > 0) label += ' ';
+        label += axes_[a].key + "=" + axes_[a].values[ValueIndex(cell, a)];
+    }
+    return label;
+}
@@ -0,0 +1,67 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// sweep_spec.h - 参数扫描规格 (INI 文件)
+//
+//   [base]                  ; 所有单元共同的参数 (键名同 GeneratorParams::Set)
+//   preset = medium
+//   stock_width = 200
+//
+//   [sweep]                 ; 扫描维度, 逗号分隔的取值, 按笛卡尔积展开
+//   num_types = 10, 20, 40
+//   max_size_ratio = 0.25, 0.35
+//   strategy = 0, 1, 3
+//   seed = 1, 2, 3          ; 重复实验种子
+//
+//   [run]
+//   count = 10              ; 每个单元生成的算例数 (批内序号 0..count-1)
+//
+// 单元按维度出现顺序编号, 最后一个维度变化最快
+
+#ifndef CS_2D_DATA_SWEEP_SPEC_H_
+#define CS_2D_DATA_SWEEP_SPEC_H_
+
+#include "generator.h"
+#include <string>
+#include <vector>
+
+struct SweepAxis {
+    std::string key;
+    std::vector<std::string> values;
+};
+
+class SweepSpec {
+public:
+    // 读取规格文件; 失败时 Error() 给出原因
+    bool Load(const std::string& filepath);
+
+    // 单元数 (各维度取值数之积)
+    size_t NumCells() const;
+
+    // 第cell个单元的参数: 基础参数上依次应用各维度取值 ("preset" 维度最先应用)
+    GeneratorParams CellParams(size_t cell) const;
+
+    // 单元标签, 如 "num_types=20 strategy=1"
+    std::string CellLabel(size_t cell) const;
+
+    const GeneratorParams& Base() const { return base_; }
+    const std::vector<SweepAxis>& Axes() const { return axes_; }
+    int Count() const { return count_; }
+    const std::string& Error() const { return error_; }
+
+private:
+    GeneratorParams base_;
+    std::vector<SweepAxis> axes_;
+    int count_ = 1;
+    std::string error_;
+
+    // 第cell个单元中第axis维的取值序号
+    size_t ValueIndex(size_t cell, size_t axis) const;
+};
+
+#endif  // CS_2D_DATA_SWEEP_SPEC_H_
@@ -0,0 +1,233 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// virtual_corpus.cpp - 虚拟语料清单读写与内存物化实现
+
+#include "virtual_corpus.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr const char* kWeightKeys[DifficultyEstimator::kNumFactors] = {
+    "w_size_ratio", "w_num_types", "w_demand", "w_cv", "w_width_div", "w_patterns"
+};
+
+std::string Trim(const std::string& s) {
+    size_t b = s.find_first_not_of(" \t\r");
+    if (b == std::string::npos) return std::string();
+    size_t e = s.find_last_not_of(" \t\r");
+    return s.substr(b, e - b + 1);
+}
+
+// 往返精确的浮点格式
+std::string Real(double v) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.17g", v);
+    return buf;
+}
+
+bool ParseReal(const std::string& s, double& value) {
+    if (s.empty()) return false;
+    char* end = nullptr;
+    value = std::strtod(s.c_str(), &end);
+    return *end == '\0';
+}
+
+bool ParseCount(const std::string& s, uint64_t& value) {
+    if (s.empty() || s[0] == '-') return false;
+    char* end = nullptr;
+    value = std::strtoull(s.c_str(), &end, 10);
+    return *end == '\0';
+}
+
+}  // namespace
+
+VirtualCorpus VirtualCorpus::FromBatch(const GeneratorParams& params, RngEngine engine,
+    uint64_t count, const BatchOptions& options, const DifficultyEstimator& estimator) {
+    VirtualCorpus corpus;
+    corpus.params = params;
+    corpus.engine = engine;
+    corpus.count = count;
+    corpus.target_score = options.target_score;
+    corpus.target_tolerance = options.target_tolerance;
+    corpus.min_gap_to_lb = options.min_gap_to_lb;
+    double* w = corpus.weights;
+    estimator.GetWeights(w[0], w[1], w[2], w[3], w[4]);
+    w[5] = estimator.GetPatternWeight();
+    return corpus;
+}
+
+bool VirtualCorpus::Save(const std::string& filepath) const {
+    std::ofstream file(filepath);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open file " << filepath << std::endl;
+        return false;
+    }
+    file << "# CS-2D-Data virtual corpus\n";
+    file << "# 批内第k个算例 = 以下设置下 -s seed --index k 的生成结果\n";
+    file << "format = " << kFormatVersion << "\n";
+    file << "rng = " << RngEngineName(engine) << "\n";
+    file << "count = " << count << "\n";
+    file << "target_score = " << Real(target_score) << "\n";
+    file << "target_tolerance = " << Real(target_tolerance) << "\n";
+    file << "min_gap_to_lb = " << Real(min_gap_to_lb) << "\n";
+    for (int i = 0; i < DifficultyEstimator::kNumFactors; i++) {
+        file << kWeightKeys[i] << " = " << Real(weights[i]) << "\n";
+    }
+    for (const auto& kv : params.ToKeyValues()) {
+        file << kv.first << " = " << kv.second << "\n";
+    }
+    file.close();
+    if (!file) {
+        std::cerr << "Error: Failed to write file " << filepath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool VirtualCorpus::Load(const std::string& filepath) {
+    *this = VirtualCorpus();
+    std::ifstream file(filepath);
+    if (!file.is_open()) {
+        error_ = "cannot open file";
+        return false;
+    }
+
+    bool has_format = false;
+    bool has_count = false;
+    std::string line;
+    int line_no = 0;
+    while (std::getline(file, line)) {
+        line_no++;
+        std::string text = Trim(line);
+        if (text.empty() || text[0] == '#') continue;
+        size_t eq = text.find('=');
+        if (eq == std::string::npos) {
+            error_ = "line " + std::to_string(line_no) + ": expected key = value";
+            return false;
+        }
+        std::string key = Trim(text.substr(0, eq));
+        std::string value = Trim(text.substr(eq + 1));
+
+        bool ok = true;
+        if (key == "format") {
+            ok = value == std::to_string(kFormatVersion);
+            has_format = ok;
+        } else if (key == "rng") {
+            ok = ParseRngEngine(value, engine);
+        } else if (key == "count") {
+            ok = ParseCount(value, count);
+            has_count = ok;
+        } else if (key == "target_score") {
+            ok = ParseReal(value, target_score);
+        } else if (key == "target_tolerance") {
+            ok = ParseReal(value, target_tolerance);
+        } else if (key == "min_gap_to_lb") {
+            ok = ParseReal(value, min_gap_to_lb);
+        } else {
+            auto it = std::find(std::begin(kWeightKeys), std::end(kWeightKeys), key);
+            if (it != std::end(kWeightKeys)) {
+                ok = ParseReal(value, weights[it - std::begin(kWeightKeys)]);
+            } else {
+                ok = params.Set(key, value);
+            }
+        }
+        if (!ok) {
+            error_ = "line " + std::to_string(line_no) + ": bad value " + key + " = " + value;
+            return false;
+        }
+    }
+
+    if (!has_format || !has_count) {
+        error_ = "missing format or count";
+        return false;
+    }
+    if (params.seed == 0 || !params.Validate()) {
+        error_ = "invalid generator parameters";
+        return false;
+    }
+    return true;
+}
+
+BatchOptions VirtualCorpus::ApplyTo(const BatchOptions& base) const {
+    BatchOptions options = base;
+    options.target_score = target_score;
+    options.target_tolerance = target_tolerance;
+    options.min_gap_to_lb = min_gap_to_lb;
+    return options;
+}
+
+void VirtualCorpus::ApplyTo(DifficultyEstimator& estimator) const {
+    estimator.SetWeights(weights[0], weights[1], weights[2], weights[3], weights[4]);
+    estimator.SetPatternWeight(weights[5]);
+}
+
+void VirtualCorpus::ShardRange(uint64_t shard, uint64_t num_shards,
+                               uint64_t& begin, uint64_t& end) const {
+    num_shards = std::max<uint64_t>(num_shards, 1);
+    shard = std::min(shard, num_shards - 1);
+    // 各分片大小至多相差 1
+    auto boundary = [&](uint64_t k) {
+        return (count / num_shards) * k + std::min(k, count % num_shards);
+    };
+    begin = boundary(shard);
+    end = boundary(shard + 1);
+}
+
+uint64_t VirtualCorpus::Materialize(uint64_t begin, uint64_t end, int num_jobs,
+                                    const Callback& callback) const {
+    end = std::min(end, count);
+    if (begin >= end) return 0;
+    if (num_jobs <= 0) {
+        num_jobs = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    num_jobs = static_cast<int>(std::clamp<uint64_t>(num_jobs, 1, end - begin));
+
+    std::atomic<uint64_t> next(begin);
+    std::atomic<uint64_t> delivered(0);
+    const bool targeted = target_score >= 0.0;
+
+    auto worker_main = [&](int worker_id) {
+        InstanceGenerator generator(worker_id + 1, engine);
+        ApplyTo(generator.GetEstimator());
+        GenerationResult result;
+        for (uint64_t i = next.fetch_add(1); i < end; i = next.fetch_add(1)) {
+            if (targeted) {
+                result = generator.GenerateTargeted(params, i, target_score, target_tolerance);
+            } else {
+                generator.GenerateInto(params, i, result);
+            }
+            if (!result.success) continue;
+            if (min_gap_to_lb >= 0.0) {
+                generator.ComputeUpperBound(result);
+                double gap = result.bounds.GapToLowerBound();
+                if (gap >= 0.0 && gap < min_gap_to_lb) continue;
+            }
+            callback(i, result);
+            delivered.fetch_add(1);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_jobs - 1);
+    for (int w = 1; w < num_jobs; w++) {
+        threads.emplace_back(worker_main, w);
+    }
+    worker_main(0);
+    for (auto& t : threads) {
+        t.join();
+    }
+    return delivered.load();
+}
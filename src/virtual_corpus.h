@@ -0,0 +1,69 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// virtual_corpus.h - 虚拟语料清单
+// 批内第k个算例完全由 (生成参数, 随机数引擎, 批次种子, k) 以及预估器权重、目标难度与下界筛选设置决定,
+// 清单只记录这些设置和序号范围, 任意子集可按需并行重新生成 (物化), 与原批次逐字节一致
+//
+// 文本格式 (key = value, '#' 注释):
+//   format = 1
+//   rng = xoshiro256
+//   count = 1000000
+//   target_score = -1 / target_tolerance = 0.05 / min_gap_to_lb = -1
+//   w_size_ratio = ... (预估器六项权重)
+//   num_types = 20 ... seed = 42 (GeneratorParams::ToKeyValues 的全部键)
+
+#ifndef CS_2D_DATA_VIRTUAL_CORPUS_H_
+#define CS_2D_DATA_VIRTUAL_CORPUS_H_
+
+#include "generator.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+
+class VirtualCorpus {
+public:
+    static constexpr int kFormatVersion = 1;
+
+    GeneratorParams params;             // 批次参数 (seed 为已确定的批次种子)
+    RngEngine engine = RngEngine::kXoshiro256;
+    uint64_t count = 0;                 // 批内算例数, 有效序号为 [0, count)
+    double target_score = -1.0;         // 目标难度 (<0 = 不使用)
+    double target_tolerance = 0.05;
+    double min_gap_to_lb = -1.0;        // 下界筛选阈值 (<0 = 不筛选)
+    double weights[DifficultyEstimator::kNumFactors] = {};  // 预估器权重
+
+    // 由批次设置构造 (params.seed 须非零)
+    static VirtualCorpus FromBatch(const GeneratorParams& params, RngEngine engine,
+                                   uint64_t count, const BatchOptions& options,
+                                   const DifficultyEstimator& estimator);
+
+    bool Save(const std::string& filepath) const;
+    bool Load(const std::string& filepath);
+    const std::string& Error() const { return error_; }
+
+    // 批次设置还原 (目标难度与下界筛选), 其余选项保持 base 原值
+    BatchOptions ApplyTo(const BatchOptions& base) const;
+
+    // 将权重写入预估器
+    void ApplyTo(DifficultyEstimator& estimator) const;
+
+    // 第 shard 个分片 (共 num_shards 个) 的连续序号区间 [begin, end)
+    void ShardRange(uint64_t shard, uint64_t num_shards, uint64_t& begin, uint64_t& end) const;
+
+    // 内存物化: 并行重新生成 [begin, end) 内的算例, 对每个成功且未被筛除的算例调用
+    // callback(序号, 结果); 回调在工作线程上并发调用. 返回交付的算例数
+    using Callback = std::function<void(uint64_t index, const GenerationResult& result)>;
+    uint64_t Materialize(uint64_t begin, uint64_t end, int num_jobs,
+                         const Callback& callback) const;
+
+private:
+    std::string error_;
+};
+
+#endif  // CS_2D_DATA_VIRTUAL_CORPUS_H_
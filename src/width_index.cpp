@@ -0,0 +1,79 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// width_index.cpp - 逆向生成用的宽度索引实现
+
+#include "width_index.h"
+#include <algorithm>
+#include <numeric>
+
+void WidthIndex::Build(const std::vector<std::pair<int, int>>& sizes) {
+    const int n = static_cast<int>(sizes.size());
+
+    // 按宽度排序, 同宽度内保持类型序号升序 (以序号为次关键字, 无需稳定排序的临时缓冲)
+    members_.resize(n);
+    std::iota(members_.begin(), members_.end(), 0);
+    std::sort(members_.begin(), members_.end(), [&sizes](int a, int b) {
+        return sizes[a].first != sizes[b].first ? sizes[a].first < sizes[b].first : a < b;
+    });
+
+    sorted_widths_.resize(n);
+    prefix_min_type_.resize(n);
+    member_lengths_.resize(n);
+    group_of_type_.resize(n);
+    group_begin_.clear();
+
+    for (int i = 0; i < n; i++) {
+        int type = members_[i];
+        sorted_widths_[i] = sizes[type].first;
+        member_lengths_[i] = sizes[type].second;
+        prefix_min_type_[i] = (i == 0) ? type : std::min(prefix_min_type_[i - 1], type);
+
+        if (i == 0 || sorted_widths_[i] != sorted_widths_[i - 1]) {
+            group_begin_.push_back(i);
+        }
+        group_of_type_[type] = static_cast<int>(group_begin_.size()) - 1;
+    }
+    group_begin_.push_back(n);
+
+    // 组内长度排序副本, 用于二分计数
+    sorted_lengths_ = member_lengths_;
+    for (size_t g = 0; g + 1 < group_begin_.size(); g++) {
+        std::sort(sorted_lengths_.begin() + group_begin_[g],
+                  sorted_lengths_.begin() + group_begin_[g + 1]);
+    }
+}
+
+int WidthIndex::FirstFittingType(int remaining_width) const {
+    auto it = std::upper_bound(sorted_widths_.begin(), sorted_widths_.end(),
+                               remaining_width);
+    if (it == sorted_widths_.begin()) return -1;
+    return prefix_min_type_[(it - sorted_widths_.begin()) - 1];
+}
+
+int WidthIndex::CountFitting(int group, int remaining_length) const {
+    auto begin = sorted_lengths_.begin() + group_begin_[group];
+    auto end = sorted_lengths_.begin() + group_begin_[group + 1];
+    return static_cast<int>(std::upper_bound(begin, end, remaining_length) - begin);
+}
+
+int WidthIndex::KthFitting(int group, int remaining_length, int k) const {
+    int begin = group_begin_[group];
+    int end = group_begin_[group + 1];
+
+    // 全部可放入 (最常见): 直接定位
+    if (sorted_lengths_[end - 1] <= remaining_length) {
+        return members_[begin + k];
+    }
+    for (int i = begin; i < end; i++) {
+        if (member_lengths_[i] <= remaining_length && k-- == 0) {
+            return members_[i];
+        }
+    }
+    return -1;
+}
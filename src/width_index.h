@@ -0,0 +1,49 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// width_index.h - 逆向生成用的宽度索引
+// 每个算例构建一次, 条带与子板选择不再逐次扫描全部类型:
+// - 条带回退: 宽度 <= 剩余宽度的最小序号类型, 二分 + 前缀最小值, O(log n)
+// - 子板候选数: 组内长度有序, 二分计数, O(log g)
+// - 子板选取: 组内按类型序号取第k个可放入类型 (全部可放入时 O(1)),
+//   与逐类型扫描的选取结果完全一致, 保证 mt19937 兼容模式可复现
+
+#ifndef CS_2D_DATA_WIDTH_INDEX_H_
+#define CS_2D_DATA_WIDTH_INDEX_H_
+
+#include <utility>
+#include <vector>
+
+class WidthIndex {
+public:
+    // 由类型尺寸 (width, length) 构建索引
+    void Build(const std::vector<std::pair<int, int>>& sizes);
+
+    // 宽度 <= remaining_width 的最小序号类型, 无则返回 -1
+    int FirstFittingType(int remaining_width) const;
+
+    // 类型所在宽度组
+    int GroupOf(int type) const { return group_of_type_[type]; }
+
+    // 组内长度 <= remaining_length 的类型数
+    int CountFitting(int group, int remaining_length) const;
+
+    // 组内按类型序号排列的第k个 (0起) 长度 <= remaining_length 的类型
+    int KthFitting(int group, int remaining_length, int k) const;
+
+private:
+    std::vector<int> sorted_widths_;     // 全部类型宽度 (升序)
+    std::vector<int> prefix_min_type_;   // 宽度升序前i+1个类型中的最小序号
+    std::vector<int> group_of_type_;     // 类型 -> 宽度组
+    std::vector<int> group_begin_;       // 组起点 (组数+1个元素)
+    std::vector<int> members_;           // 组内类型, 按序号升序
+    std::vector<int> member_lengths_;    // 与 members_ 对齐的长度
+    std::vector<int> sorted_lengths_;    // 组内长度升序
+};
+
+#endif  // CS_2D_DATA_WIDTH_INDEX_H_
@@ -0,0 +1,111 @@
+// ============================================================================
+// 工程标准 (Engineering Standards)
+// - 坐标系: 左下角为原点
+// - 宽度(Width): 上下方向 (Y轴)
+// - 长度(Length): 左右方向 (X轴)
+// - 约束: 长度 >= 宽度
+// ============================================================================
+
+// work_stealing.h - 工作窃取线程池
+// 每个工作线程持有一个双端队列: 自己从尾部取最新任务 (局部性好), 空闲时从其他线程头部窃取最老任务
+// (通常是尚未拆分的大块). 任务粒度粗 (一个算例起), 每个队列用一把互斥锁即可, 无需无锁双端队列
+
+#ifndef CS_2D_DATA_WORK_STEALING_H_
+#define CS_2D_DATA_WORK_STEALING_H_
+
+#include "bounded_queue.h"
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+template <typename Task>
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(int num_workers)
+        : num_workers_(num_workers < 1 ? 1 : num_workers),
+          queues_(new Queue[num_workers_]) {}
+
+    int NumWorkers() const { return num_workers_; }
+
+    // 放入 worker 的队列尾部 (运行前用于分发初始任务, 运行中用于拆分任务)
+    void Push(int worker, const Task& task) {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        Queue& q = queues_[worker];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.tasks.push_back(task);
+    }
+
+    // 运行全部任务直到没有未完成任务; fn(worker, task) 可调用 Push 拆分出新任务
+    template <typename Fn>
+    void Run(Fn&& fn) {
+        auto worker_main = [&](int worker) {
+            Backoff backoff;
+            Task task;
+            for (;;) {
+                if (Pop(worker, task)) {
+                    fn(worker, task);
+                    // 拆分出的子任务已先计入, 计数不会提前归零
+                    pending_.fetch_sub(1, std::memory_order_acq_rel);
+                    backoff.Reset();
+                } else if (pending_.load(std::memory_order_acquire) == 0) {
+                    break;
+                } else {
+                    backoff.Wait();
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(num_workers_ - 1);
+        for (int w = 1; w < num_workers_; w++) {
+            threads.emplace_back(worker_main, w);
+        }
+        worker_main(0);
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+
+    // 成功窃取的任务数 (调度统计)
+    long long Steals() const { return steals_.load(std::memory_order_relaxed); }
+
+private:
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    int num_workers_;
+    std::unique_ptr<Queue[]> queues_;
+    std::atomic<long long> pending_{0};     // 已放入但未执行完的任务数
+    std::atomic<long long> steals_{0};
+
+    bool Pop(int worker, Task& task) {
+        {
+            Queue& q = queues_[worker];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (!q.tasks.empty()) {
+                task = q.tasks.back();
+                q.tasks.pop_back();
+                return true;
+            }
+        }
+        // 从下一个线程开始轮询窃取, 分散争用
+        for (int k = 1; k < num_workers_; k++) {
+            Queue& q = queues_[(worker + k) % num_workers_];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (!q.tasks.empty()) {
+                task = q.tasks.front();
+                q.tasks.pop_front();
+                steals_.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+#endif  // CS_2D_DATA_WORK_STEALING_H_